@@ -0,0 +1,292 @@
+/**********************************************************
+* Description: Runs the scenarios of a MovingAI benchmark
+* through the path finding engines, without a window.
+*
+* Usage: PathFinderBenchmark <file.map> <file.scen> [--batch] [engine...]
+*
+* For each engine it prints how many tiles the search expanded
+* and the most it had in its open list, the average time per
+* query, the 50th and 99th percentile times, and how long its
+* paths are compared to the shortest. A path only counts as
+* solved if it goes from the start tile to the end tile one
+* step at a time through tiles that aren't blocked. Any other
+* path is counted as invalid.
+* The scenario files give shortest lengths with diagonal steps,
+* so the shortest 4 direction lengths are found again here with
+* a breadth first search.
+*
+* Setting PATHFINDER_TRACE to a file name writes a trace of
+* every query to it, for chrome://tracing or Perfetto.
+*
+* With --batch, every scenario is instead found at once by a
+* BatchSolver, with 1, 2, 4... worker threads up to one for
+* every core, or 4 on machines with fewer cores, and it prints the queries per second each time and
+* how much faster that is than one worker. BatchSolver uses
+* plain A* for the engines that can't run several searches at
+* once.
+*
+* Engines can be named to run only those. The Compressed Path
+* Database has to search from every tile to build, so it is
+* left out on big maps unless it is named.
+**********************************************************/
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <chrono>
+#include <thread>
+#include "PathSolver.h"
+#include "BatchSolver.h"
+#include "MovingAI.h"
+#include "PathCheck.h"
+#include "Trace.h"
+using std::vector;
+
+struct EngineName
+{
+	const char* Name;
+	SearchEngine Engine;
+};
+
+const EngineName Engines[] =
+{
+	{ "astar", ASTAR }, { "buckets", ASTARBUCKETS }, { "jps", JPS }, { "jpsplus", JPSPLUS }, { "hpa", HPA },
+	{ "dstarlite", DSTARLITE }, { "bitboard", BITBOARD }, { "sliced", ASTARSLICED }, { "arastar", ARASTAR },
+	{ "flowfield", FLOWFIELD }, { "bidirectional", BIDIRECTIONAL }, { "landmarks", ASTARLANDMARKS }, { "cpd", CPD }
+};
+
+const int CPD_MAX_TILES = 128 * 128; //Bigger maps take minutes to build a database for
+const double BATCH_MIN_SECONDS = 0.5; //A batch is run again until this much time has passed, so short batches can be timed
+
+static const char* GetName(SearchEngine Engine)
+{
+	return std::find_if(std::begin(Engines), std::end(Engines), [&](const EngineName& e) { return e.Engine == Engine; })->Name;
+}
+
+//Wait for anything the engine builds on its own thread, so it isn't timed
+static void PrepareAndWait(PathSolver& Paths, SearchEngine Engine)
+{
+	Paths.Prepare(Engine);
+	if (Engine == ASTARLANDMARKS)
+	{
+		while (!Paths.Landmarks.GetTable())
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+}
+
+//Find every query at once with 1, 2, 4... workers, up to one per core, and print how many queries a second each managed.
+//At least 4 are tried, so the cost of more workers than cores shows up on small machines.
+static void RunBatches(PathSolver& Paths, const vector<SearchEngine>& Chosen, const vector<std::pair<int, int>>& Queries)
+{
+	int MaxWorkers = std::max(4, (int)std::thread::hardware_concurrency());
+	vector<int> WorkerCounts;
+	for (int w = 1; w < MaxWorkers; w *= 2)
+		WorkerCounts.push_back(w);
+	WorkerCounts.push_back(MaxWorkers);
+
+	printf("%-14s %8s %8s %12s %8s\n", "Engine", "Workers", "Solved", "Queries/s", "Speedup");
+	for (SearchEngine Engine : Chosen)
+	{
+		PrepareAndWait(Paths, Engine);
+		double OneWorker = 0;
+		for (int WorkerCount : WorkerCounts)
+		{
+			BatchSolver Batch(Paths, WorkerCount);
+			int Solved = 0;
+			long Runs = 0;
+			auto BatchStart = std::chrono::steady_clock::now();
+			double Seconds = 0;
+			do
+			{
+				vector<CompactPath> Found = Batch.FindPaths(Queries, Engine);
+				Solved = (int)std::count_if(Found.begin(), Found.end(), [](const CompactPath& p) { return !p.Empty(); });
+				++Runs;
+				Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - BatchStart).count();
+			} while (Seconds < BATCH_MIN_SECONDS);
+
+			double QueriesPerSecond = Runs * Queries.size() / Seconds;
+			if (WorkerCount == 1)
+				OneWorker = QueriesPerSecond;
+			printf("%-14s %8d %8d %12.0f %7.2fx\n", GetName(Engine), WorkerCount, Solved, QueriesPerSecond, QueriesPerSecond / OneWorker);
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 3)
+	{
+		printf("Usage: %s <file.map> <file.scen> [--batch] [engine...]\nEngines:", argv[0]);
+		for (const EngineName& e : Engines)
+			printf(" %s", e.Name);
+		printf("\n");
+		return 1;
+	}
+
+	TileMap Map;
+	if (!LoadMovingAIMap(argv[1], Map))
+	{
+		fprintf(stderr, "Could not read the map %s\n", argv[1]);
+		return 1;
+	}
+
+	vector<Scenario> Scenarios;
+	if (!LoadMovingAIScenarios(argv[2], Scenarios))
+	{
+		fprintf(stderr, "Could not read the scenarios %s\n", argv[2]);
+		return 1;
+	}
+
+	//Pick the engines to run
+	vector<SearchEngine> Chosen;
+	bool BatchMode = false;
+	for (int a = 3; a < argc; ++a)
+	{
+		if (strcmp(argv[a], "--batch") == 0)
+		{
+			BatchMode = true;
+			continue;
+		}
+
+		const EngineName* Found = std::find_if(std::begin(Engines), std::end(Engines), [&](const EngineName& e) { return strcmp(e.Name, argv[a]) == 0; });
+		if (Found == std::end(Engines))
+		{
+			fprintf(stderr, "Unknown engine %s\n", argv[a]);
+			return 1;
+		}
+		Chosen.push_back(Found->Engine);
+	}
+	if (Chosen.empty())
+	{
+		for (const EngineName& e : Engines)
+		{
+			if (e.Engine != CPD || Map.Size() <= CPD_MAX_TILES)
+				Chosen.push_back(e.Engine);
+		}
+	}
+
+	//Turn the scenarios into tiles, and find their shortest 4 direction lengths
+	vector<int> Starts;
+	vector<int> Ends;
+	vector<int> Shortest;
+	vector<int> Distances;
+	vector<int> Queue;
+	int Skipped = 0;
+	for (const Scenario& s : Scenarios)
+	{
+		if (s.StartX < 0 || s.StartY < 0 || s.EndX < 0 || s.EndY < 0 ||
+			s.StartX >= Map.Width || s.StartY >= Map.Height || s.EndX >= Map.Width || s.EndY >= Map.Height)
+		{
+			++Skipped;
+			continue;
+		}
+
+		int Start = Map.GetIndex(s.StartX, s.StartY);
+		int End = Map.GetIndex(s.EndX, s.EndY);
+		int Length = FindShortestLength(Map, Start, End, Distances, Queue);
+		if (Length <= 0)
+		{
+			++Skipped;
+			continue;
+		}
+
+		Starts.push_back(Start);
+		Ends.push_back(End);
+		Shortest.push_back(Length);
+	}
+	printf("%s: %dx%d, %d scenarios", argv[1], Map.Width, Map.Height, (int)Starts.size());
+	if (Skipped)
+		printf(" (%d left out, off the map or with no 4 direction path)", Skipped);
+	printf("\n\n");
+
+	if (BatchMode)
+	{
+		PathSolver Paths(Map);
+		vector<std::pair<int, int>> Queries;
+		for (size_t q = 0; q < Starts.size(); ++q)
+			Queries.emplace_back(Starts[q], Ends[q]);
+		RunBatches(Paths, Chosen, Queries);
+		return 0;
+	}
+
+	printf("%-14s %10s %8s %8s %10s %10s %10s %10s %10s %10s %8s %8s\n",
+		"Engine", "Prepare ms", "Solved", "Invalid", "Expanded", "Peak open", "us/query", "p50 us", "p99 us", "Cost/best", "Worst", "Longer");
+
+	//Set PATHFINDER_TRACE to a file name to record every query
+	StartTracingFromEnvironment();
+
+	//Every engine uses the connected areas, so they are found before any engine is timed
+	PathSolver Paths(Map);
+	Paths.Prepare(ASTAR);
+	SearchContext Context;
+	for (SearchEngine Engine : Chosen)
+	{
+		auto PrepareStart = std::chrono::steady_clock::now();
+		PrepareAndWait(Paths, Engine);
+		double PrepareMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - PrepareStart).count();
+
+		vector<double> Times;
+		long Expanded = 0;
+		int PeakOpen = 0;
+		int Solved = 0;
+		int Invalid = 0;
+		int Longer = 0;
+		double RatioSum = 0;
+		double WorstRatio = 1;
+		for (size_t q = 0; q < Starts.size(); ++q)
+		{
+			auto QueryStart = std::chrono::steady_clock::now();
+			vector<int> Path = Paths.FindPath(Context, Engine, Starts[q], Ends[q]);
+			Times.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - QueryStart).count());
+			Expanded += Context.Stats.Expanded;
+			PeakOpen = std::max(PeakOpen, Context.Stats.PeakOpen);
+
+			if (Path.empty())
+				continue;
+
+			if (!IsValidPath(Map, Path, Starts[q], Ends[q]))
+			{
+				++Invalid;
+				continue;
+			}
+
+			++Solved;
+			double Ratio = (double)(Path.size() - 1) / Shortest[q];
+			RatioSum += Ratio;
+			WorstRatio = std::max(WorstRatio, Ratio);
+			Longer += (int)Path.size() - 1 > Shortest[q];
+		}
+
+		const char* Name = GetName(Engine);
+		if (Times.empty())
+		{
+			printf("%-14s %10.1f %8d %8d\n", Name, PrepareMilliseconds, 0, 0);
+			continue;
+		}
+
+		double TotalTime = 0;
+		for (double t : Times)
+			TotalTime += t;
+		std::sort(Times.begin(), Times.end());
+		double p50 = Times[Times.size() / 2];
+		double p99 = Times[std::min(Times.size() - 1, Times.size() * 99 / 100)];
+
+		char ExpandedText[16] = "-";
+		char PeakOpenText[16] = "-";
+		if (Expanded > 0)
+		{
+			snprintf(ExpandedText, sizeof(ExpandedText), "%.0f", (double)Expanded / Times.size());
+			snprintf(PeakOpenText, sizeof(PeakOpenText), "%d", PeakOpen);
+		}
+
+		printf("%-14s %10.1f %8d %8d %10s %10s %10.2f %10.2f %10.2f %10.4f %8.3f %8d\n",
+			Name, PrepareMilliseconds, Solved, Invalid, ExpandedText, PeakOpenText, TotalTime / Times.size(), p50, p99,
+			Solved ? RatioSum / Solved : 0, WorstRatio, Longer);
+	}
+	printf("\nExpanded and peak open are - for engines that don't search tile by tile in a SearchContext.\n");
+
+	if (!StopTracing())
+		fprintf(stderr, "Could not write the trace\n");
+	return 0;
+}
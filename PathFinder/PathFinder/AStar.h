@@ -0,0 +1,246 @@
+/**********************************************************
+* Description: The A* search, shared by everything that runs
+* it. It only reads the map, and writes to the search planes
+* and open list of the SearchContext it is given.
+*
+* AStarSearch can be stopped and picked up again, so a search
+* can be spread over several frames by giving each Step a
+* budget of tiles to expand or of time to spend. Between steps
+* the open and closed tiles can be read from the context's List
+* plane to show how far the search has got.
+*
+* The open list can be an IndexedHeap or a BucketQueue.
+*
+* The distance estimate is Manhattan distance, or the larger of
+* that and the landmark bound when a LandmarkTable is given.
+**********************************************************/
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include "TileMap.h"
+#include "SearchContext.h"
+#include "LandmarkTable.h"
+
+enum SearchStatus
+{
+	IDLE, //No search has been started
+	SEARCHING, //The search has more tiles to expand
+	FOUND, //The path has been found
+	NOT_FOUND //Every reachable tile was expanded without finding the end tile
+};
+
+template <typename OpenListType>
+class AStarSearch
+{
+public:
+	//Open has to belong to Context, either its OpenList or its OpenBuckets
+	AStarSearch(const TileMap& _Map, SearchContext& _Context, OpenListType& _Open) : Map(_Map), Context(_Context), Open(_Open) {}
+
+	//Start a search from Start to End. Nothing is expanded until Step is called.
+	//Landmarks has to match the grid and stay alive until the search is done.
+	void Begin(int Start, int End, const LandmarkTable* _Landmarks = nullptr);
+
+	//Expand at most MaxExpansions tiles, and stop early once MaxMicroseconds have passed if it is above 0
+	SearchStatus Step(int MaxExpansions, double MaxMicroseconds = 0);
+
+	//Drop the search, for when the context is about to be used by another search
+	void Stop() { Progress = IDLE; }
+
+	//Add every tile the search opens or closes to Changed from now on, so whoever shows the search
+	//can draw just those tiles again. Changed has to outlive the search. nullptr stops recording.
+	void RecordChanges(std::vector<int>* _Changed) { Changed = _Changed; }
+
+	SearchStatus GetStatus() const { return Progress; }
+
+	//The path once the status is FOUND
+	const std::vector<int>& GetPath() const { return Path; }
+
+private:
+	//Called on the way out of Step to add what it did to the context's Stats. Counting into Counts while
+	//searching lets the compiler keep the counts in registers.
+	SearchStatus Finish(std::chrono::steady_clock::time_point StepStart, const SearchStats& Counts)
+	{
+		Context.Stats.Add(Counts);
+		Context.Stats.Microseconds += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - StepStart).count();
+		if (Progress == FOUND)
+			Context.Stats.PathLength = (int)Path.size();
+		return Progress;
+	}
+
+	int GetDistance(int t) const
+	{
+		int Distance = abs(Map.GetX(t) - EndX) + abs(Map.GetY(t) - EndY);
+		if (Landmarks)
+			Distance = std::max(Distance, Landmarks->GetBound(t, EndTile));
+		return Distance;
+	}
+
+	const TileMap& Map;
+	SearchContext& Context;
+	OpenListType& Open;
+	const LandmarkTable* Landmarks = nullptr;
+	std::vector<int>* Changed = nullptr;
+	SearchStatus Progress = IDLE;
+	int EndTile = -1;
+	int EndX = 0;
+	int EndY = 0;
+	std::vector<int> Path;
+};
+
+template <typename OpenListType>
+void AStarSearch<OpenListType>::Begin(int StartTile, int End, const LandmarkTable* _Landmarks)
+{
+	Landmarks = _Landmarks;
+	EndTile = End;
+	EndX = Map.GetX(EndTile);
+	EndY = Map.GetY(EndTile);
+	Path.clear();
+
+	Context.BeginSearch(Map.Size());
+	Open.Clear();
+	Context.Touch(StartTile);
+	Context.G[StartTile] = 0;
+	Open.Push(StartTile, GetDistance(StartTile), GetDistance(StartTile));
+	Context.Stats.CountPush(Open.Size());
+	Context.List[StartTile] = OPENED;
+	if (Changed)
+		Changed->push_back(StartTile);
+	Progress = SEARCHING;
+
+	//The goal is only tested for when a neighbor is reached, so a path to the start tile itself is found here
+	if (StartTile == End)
+	{
+		Path.assign(1, StartTile);
+		Context.Stats.PathLength = 1;
+		Progress = FOUND;
+	}
+}
+
+template <typename OpenListType>
+SearchStatus AStarSearch<OpenListType>::Step(int MaxExpansions, double MaxMicroseconds)
+{
+	if (Progress != SEARCHING)
+		return Progress;
+
+	auto StepStart = std::chrono::steady_clock::now();
+	SearchStats Counts;
+	for (int Expanded = 0; Expanded < MaxExpansions; ++Expanded)
+	{
+		if (Open.Empty())
+		{
+			Progress = NOT_FOUND;
+			return Finish(StepStart, Counts);
+		}
+
+		//Reading the clock for every tile would cost more than the check is worth
+		if (MaxMicroseconds > 0 && (Expanded & 31) == 31 &&
+			std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - StepStart).count() >= MaxMicroseconds)
+			return Finish(StepStart, Counts);
+
+		//Remove the Tile with the smallest f value from the open list.
+		//Ties go to the tile closest to the goal so the search keeps moving forward.
+		int SmallestF = Open.Pop();
+
+		//A bucket queue leaves old copies of a tile behind when its f value drops
+		if (Context.List[SmallestF] == CLOSED)
+		{
+			Open.SkipStale();
+			continue;
+		}
+		Context.List[SmallestF] = CLOSED;
+		++Counts.Expanded;
+		if (Changed)
+			Changed->push_back(SmallestF);
+
+		int x = Map.GetX(SmallestF);
+		int y = Map.GetY(SmallestF);
+		int Neighbors[4];
+		int NeighborCount = 0;
+
+		if (y > 0)
+			Neighbors[NeighborCount++] = SmallestF - Map.Width; //Tile above
+
+		if (y < Map.Height - 1)
+			Neighbors[NeighborCount++] = SmallestF + Map.Width; //Tile below
+
+		if (x > 0)
+			Neighbors[NeighborCount++] = SmallestF - 1; //Tile to the left
+
+		if (x < Map.Width - 1)
+			Neighbors[NeighborCount++] = SmallestF + 1; //Tile to the right
+
+		for (int i = 0; i < NeighborCount; ++i)
+		{
+			int t = Neighbors[i];
+			if (Map.State[t] == BLOCKED)
+				continue;
+
+			Context.Touch(t);
+
+			//If neighbor is the goal
+			if (t == EndTile)
+			{
+				Context.Parent[t] = SmallestF;
+
+				for (uint32_t itr = EndTile; itr != NO_PARENT; itr = Context.Parent[itr])
+				{
+					Path.push_back(itr);
+				}
+				std::reverse(Path.begin(), Path.end());
+				Progress = FOUND;
+				return Finish(StepStart, Counts);
+			}
+			//Else if the neighbor is not in the closed list
+			else if (Context.List[t] != CLOSED)
+			{
+				uint32_t NewG = Context.G[SmallestF] + 1;
+
+				//Only update the neighbor if this is a shorter way to reach it
+				if (NewG < Context.G[t])
+				{
+					int NewH = GetDistance(t);
+					int NewF = NewG + NewH;
+					Context.G[t] = NewG;
+					Context.Parent[t] = SmallestF;
+
+					//A tile that is already in the open list is moved up instead of being added twice
+					if (Context.List[t] == OPENED)
+					{
+						Open.DecreaseKey(t, NewF, NewH);
+					}
+					else
+					{
+						Open.Push(t, NewF, NewH);
+						Counts.CountPush(Open.Size());
+						Context.List[t] = OPENED;
+						if (Changed)
+							Changed->push_back(t);
+					}
+				}
+			}
+		}
+	}
+	return Finish(StepStart, Counts);
+}
+
+struct NeverCancel
+{
+	bool operator()() const { return false; }
+};
+
+//Run a whole search at once. A search that may have to stop early can pass a function that returns true
+//once the result is no longer wanted. It is checked every so many tiles, and the search then gives up.
+template <typename OpenListType, typename CancelCheck = NeverCancel>
+std::vector<int> FindPathAStar(const TileMap& Map, SearchContext& Context, OpenListType& Open, int StartTile, int EndTile, CancelCheck IsCancelled = CancelCheck(), const LandmarkTable* Landmarks = nullptr)
+{
+	AStarSearch<OpenListType> Search(Map, Context, Open);
+	Search.Begin(StartTile, EndTile, Landmarks);
+	while (Search.Step(256) == SEARCHING)
+	{
+		if (IsCancelled())
+			return std::vector<int>();
+	}
+	return Search.GetPath(); //Empty if it cannot be found
+}
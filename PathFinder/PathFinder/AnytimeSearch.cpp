@@ -0,0 +1,160 @@
+#include "AnytimeSearch.h"
+#include <algorithm>
+#include <chrono>
+using std::vector;
+
+static long long Now()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void AnytimeSearch::Open(int t)
+{
+	if (Context.List[t] == OPENED)
+	{
+		OpenList.DecreaseKey(t, GetKey(t), GetDistance(t));
+	}
+	else
+	{
+		OpenList.Push(t, GetKey(t), GetDistance(t));
+		Context.Stats.CountPush(OpenList.Size());
+		Context.List[t] = OPENED;
+	}
+}
+
+bool AnytimeSearch::ImprovePath(double MaxMicroseconds)
+{
+	int Expanded = 0;
+	while (!OpenList.Empty())
+	{
+		//Stop once the path to the end tile is no longer than anything the open list could still lead to
+		uint32_t EndG = Context.G[EndTile];
+		if (EndG != UNREACHED && (uint64_t)EndG * 10 <= (OpenList.TopPriority() >> 32))
+			break;
+
+		if ((++Expanded & 255) == 0 && Now() - StartTime >= MaxMicroseconds)
+			return false;
+
+		int Current = OpenList.Pop();
+		Context.List[Current] = CLOSED;
+		++Context.Stats.Expanded;
+		Closed.push_back(Current);
+
+		int x = Map.GetX(Current);
+		int y = Map.GetY(Current);
+		int Neighbors[4];
+		int NeighborCount = 0;
+		if (y > 0) Neighbors[NeighborCount++] = Current - Map.Width;
+		if (y < Map.Height - 1) Neighbors[NeighborCount++] = Current + Map.Width;
+		if (x > 0) Neighbors[NeighborCount++] = Current - 1;
+		if (x < Map.Width - 1) Neighbors[NeighborCount++] = Current + 1;
+
+		for (int i = 0; i < NeighborCount; ++i)
+		{
+			int t = Neighbors[i];
+			if (Map.State[t] == BLOCKED)
+				continue;
+
+			Context.Touch(t);
+			uint32_t NewG = Context.G[Current] + 1;
+			if (NewG >= Context.G[t])
+				continue;
+
+			Context.G[t] = NewG;
+			Context.Parent[t] = Current;
+
+			//A tile that was already expanded with this weight waits for the next one
+			if (Context.List[t] == CLOSED)
+				Inconsistent.push_back(t);
+			else
+				Open(t);
+		}
+	}
+	return true;
+}
+
+void AnytimeSearch::Reopen()
+{
+	//Every tile that is open now, or got better after it was expanded, is opened again with the new weight
+	Scratch.clear();
+	while (!OpenList.Empty())
+		Scratch.push_back(OpenList.Pop());
+	for (int t : Inconsistent)
+	{
+		if (Context.List[t] == CLOSED)
+		{
+			Context.List[t] = UNLISTED;
+			Scratch.push_back(t);
+			++Context.Stats.Reopens;
+		}
+	}
+	Inconsistent.clear();
+	for (int t : Closed)
+	{
+		if (Context.List[t] == CLOSED)
+			Context.List[t] = UNLISTED;
+	}
+	Closed.clear();
+
+	//No path to the end tile can be shorter than the smallest g + h among those tiles,
+	//and the path found with the old weight can't be longer than the weight allows
+	uint32_t Smallest = UNREACHED;
+	for (int t : Scratch)
+		Smallest = std::min(Smallest, Context.G[t] + GetDistance(t));
+
+	uint32_t EndG = Context.G[EndTile];
+	if (Smallest == UNREACHED || Smallest >= EndG)
+		Bound = 1;
+	else
+		Bound = std::min(WeightTenths / 10.0, (double)EndG / Smallest);
+
+	WeightTenths = std::max(10, WeightTenths - (int)(WeightStep * 10 + 0.5));
+	for (int t : Scratch)
+	{
+		Context.List[t] = UNLISTED;
+		Open(t);
+	}
+}
+
+vector<int> AnytimeSearch::FindPath(int Start, int End, double MaxMicroseconds)
+{
+	StartTime = Now();
+	EndTile = End;
+	EndX = Map.GetX(End);
+	EndY = Map.GetY(End);
+	WeightTenths = (int)(InitialWeight * 10 + 0.5);
+	Closed.clear();
+	Inconsistent.clear();
+
+	Context.BeginSearch(Map.Size());
+	OpenList.Clear();
+	Context.Touch(Start);
+	Context.Touch(End);
+	Context.G[Start] = 0;
+	Open(Start);
+
+	//The first search has to finish no matter how long it takes, so there is a path to return
+	ImprovePath(1e300);
+	if (Context.G[End] == UNREACHED)
+		return vector<int>(); //Return empty path if it cannot be found
+
+	vector<int> Path;
+	while (true)
+	{
+		Path.clear();
+		for (uint32_t t = End; t != NO_PARENT; t = Context.Parent[t])
+			Path.push_back(t);
+		std::reverse(Path.begin(), Path.end());
+
+		//Works out the bound of this path before lowering the weight for the next one
+		bool Shortest = WeightTenths == 10;
+		Reopen();
+		if (Shortest || Now() - StartTime >= MaxMicroseconds)
+			break;
+
+		//If the time runs out part way, the last path and its bound are kept
+		if (!ImprovePath(MaxMicroseconds))
+			break;
+	}
+	return Path;
+}
@@ -0,0 +1,75 @@
+/**********************************************************
+* Description: Anytime Repairing A* (ARA*).
+*
+* The search starts with the heuristic multiplied by a weight
+* above 1. That makes it rush towards the end tile and find a
+* path quickly, which is at most weight times longer than the
+* shortest one. The weight is then lowered step by step, and
+* each search reuses the g values of the one before. Only the
+* tiles whose g values got better since they were expanded are
+* looked at again, so each improvement is cheap.
+*
+* The search stops when the weight reaches 1, which gives the
+* shortest path, or when its time runs out. Either way it
+* returns the best path it has, and GetBound says how much
+* longer than the shortest path it can be at most.
+*
+* Like AStarSearch, an AnytimeSearch is made for one search at
+* a time and keeps everything it writes in its context.
+**********************************************************/
+#pragma once
+#include <vector>
+#include <cstdlib>
+#include "TileMap.h"
+#include "SearchContext.h"
+
+class AnytimeSearch
+{
+public:
+	AnytimeSearch(const TileMap& _Map, SearchContext& _Context, double _InitialWeight = 3, double _WeightStep = 0.5)
+		: Map(_Map), Context(_Context), OpenList(_Context.OpenList), InitialWeight(_InitialWeight), WeightStep(_WeightStep),
+		Closed(_Context.Closed), Inconsistent(_Context.Inconsistent), Scratch(_Context.Reopened) {}
+
+	//Find a path from Start to End using the search planes of the context, improving it until
+	//MaxMicroseconds have passed or it is the shortest. Returns an empty path if there is none.
+	std::vector<int> FindPath(int Start, int End, double MaxMicroseconds);
+
+	//The last path found is at most this many times longer than the shortest path
+	double GetBound() const { return Bound; }
+
+private:
+	int GetDistance(int t) const
+	{
+		return abs(Map.GetX(t) - EndX) + abs(Map.GetY(t) - EndY);
+	}
+
+	//The open list is ordered by g + Weight * h. The weight is kept in tenths so the keys stay whole numbers.
+	int GetKey(int t) const { return (int)Context.G[t] * 10 + WeightTenths * GetDistance(t); }
+
+	void Open(int t);
+
+	//Expand tiles until no tile in the open list can lead to a shorter path to the end tile.
+	//Returns false if the time ran out first.
+	bool ImprovePath(double MaxMicroseconds);
+
+	//Work out the bound of the path just found, then lower the weight and
+	//put back the tiles that got better after they were expanded
+	void Reopen();
+
+	const TileMap& Map;
+	SearchContext& Context;
+	IndexedHeap& OpenList;
+	double InitialWeight;
+	double WeightStep;
+
+	int EndTile = -1;
+	int EndX = 0;
+	int EndY = 0;
+	int WeightTenths = 10;
+	double Bound = 1;
+	long long StartTime = 0; //Microseconds on the steady clock when the search started
+
+	std::vector<int>& Closed; //Tiles expanded with the current weight
+	std::vector<int>& Inconsistent; //Closed tiles whose g value got better, to expand again with the next weight
+	std::vector<int>& Scratch;
+};
@@ -0,0 +1,93 @@
+#include "AsyncSolver.h"
+#include "AStar.h"
+#include "Trace.h"
+using std::vector;
+
+AsyncSolver::~AsyncSolver()
+{
+	if (!Worker.joinable())
+		return;
+
+	{
+		std::lock_guard<std::mutex> Guard(Lock);
+		Stopping = true;
+		Cancel = true;
+	}
+	Wake.notify_one();
+	Worker.join();
+}
+
+void AsyncSolver::Start(int Width, int Height)
+{
+	WorkerMap.Create(Width, Height);
+	Worker = std::thread(&AsyncSolver::Run, this);
+}
+
+void AsyncSolver::TileChanged(int Index, TileState NewState)
+{
+	std::lock_guard<std::mutex> Guard(Lock);
+	Edits.push_back({ Index, NewState });
+}
+
+void AsyncSolver::Post(int Start, int End, uint32_t Version)
+{
+	{
+		std::lock_guard<std::mutex> Guard(Lock);
+		Pending = { Start, End, Version };
+		HasRequest = true;
+		Cancel = true;
+	}
+	Wake.notify_one();
+}
+
+bool AsyncSolver::Poll(Result& Taken)
+{
+	std::lock_guard<std::mutex> Guard(Lock);
+	if (!HasResult)
+		return false;
+
+	Taken.Path.swap(Finished.Path);
+	Taken.Version = Finished.Version;
+	Taken.Stats = Finished.Stats;
+	HasResult = false;
+	return true;
+}
+
+void AsyncSolver::Run()
+{
+	while (true)
+	{
+		Request Current;
+		{
+			std::unique_lock<std::mutex> Guard(Lock);
+			Wake.wait(Guard, [this] { return Stopping || HasRequest; });
+			if (Stopping)
+				return;
+
+			Current = Pending;
+			HasRequest = false;
+			Cancel = false;
+			Applying.swap(Edits);
+		}
+
+		//Bring the worker's map up to date with the grid the request was made for
+		for (const Edit& e : Applying)
+			WorkerMap.State[e.Index] = e.NewState;
+		Applying.clear();
+
+		vector<int> Path;
+		{
+			TraceZone Zone("Solver thread A*");
+			Path = FindPathAStar(WorkerMap, Context, Context.OpenList, Current.Start, Current.End, [this] { return Cancel.load(std::memory_order_relaxed); });
+		}
+
+		std::lock_guard<std::mutex> Guard(Lock);
+		if (!Cancel)
+		{
+			Finished.Path.swap(Path);
+			Finished.Version = Current.Version;
+			Finished.Stats = Context.Stats;
+			HasResult = true;
+		}
+	}
+}
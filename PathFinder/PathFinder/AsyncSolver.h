@@ -0,0 +1,84 @@
+/**********************************************************
+* Description: Runs A* on a worker thread so a slow search
+* never holds up a frame.
+*
+* The worker keeps its own copy of the map. Edits are queued
+* with TileChanged and applied by the worker before its next
+* search, so posting a request costs the same no matter how big
+* the map is. Every request carries the version of the grid it
+* was made for, and the result carries it back, so a result for
+* a grid that has changed since can be told apart and ignored.
+*
+* Only the newest request matters. Posting a request replaces
+* one that hasn't started yet, and asks the search that is
+* running to stop at its next check.
+**********************************************************/
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include "TileMap.h"
+#include "SearchContext.h"
+
+class AsyncSolver
+{
+public:
+	struct Result
+	{
+		std::vector<int> Path; //Empty if no path exists
+		uint32_t Version; //The grid version of the request that found it
+		SearchStats Stats; //What the search did to find it
+	};
+
+	~AsyncSolver();
+
+	//Make the worker's Width x Height map of empty tiles and start the worker
+	void Start(int Width, int Height);
+
+	//Queue a tile's new state for the worker's map
+	void TileChanged(int Index, TileState NewState);
+
+	//Ask for the path from Start to End on the grid as it is after every queued edit
+	void Post(int Start, int End, uint32_t Version);
+
+	//Takes the newest finished result, if there is one that hasn't been taken yet
+	bool Poll(Result& Finished);
+
+private:
+	struct Request
+	{
+		int Start;
+		int End;
+		uint32_t Version;
+	};
+
+	struct Edit
+	{
+		int Index;
+		TileState NewState;
+	};
+
+	void Run();
+
+	std::thread Worker;
+	std::mutex Lock;
+	std::condition_variable Wake;
+
+	//Shared with the worker. Only used while Lock is held.
+	bool Stopping = false;
+	bool HasRequest = false;
+	Request Pending;
+	std::vector<Edit> Edits;
+	bool HasResult = false;
+	Result Finished;
+
+	std::atomic<bool> Cancel{ false }; //Set when a newer request arrives while a search is running
+
+	//Only used by the worker
+	TileMap WorkerMap;
+	SearchContext Context;
+	std::vector<Edit> Applying;
+};
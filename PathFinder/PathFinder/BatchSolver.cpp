@@ -0,0 +1,144 @@
+#include "BatchSolver.h"
+#include <algorithm>
+using std::vector;
+using std::pair;
+
+BatchSolver::BatchSolver(PathSolver& _Paths, int ThreadCount) : Paths(_Paths)
+{
+	if (ThreadCount <= 0)
+		ThreadCount = std::max(1, (int)std::thread::hardware_concurrency());
+
+	for (int i = 0; i < ThreadCount; ++i)
+		Workers.emplace_back(new Worker());
+	for (int i = 0; i < ThreadCount; ++i)
+		Workers[i]->Thread = std::thread(&BatchSolver::Run, this, i);
+}
+
+BatchSolver::~BatchSolver()
+{
+	{
+		std::lock_guard<std::mutex> Guard(Lock);
+		Stopping = true;
+	}
+	Wake.notify_all();
+	for (auto& w : Workers)
+		w->Thread.join();
+}
+
+vector<CompactPath> BatchSolver::FindPaths(const vector<pair<int, int>>& _Queries, SearchEngine Engine)
+{
+	vector<CompactPath> Found(_Queries.size());
+	if (_Queries.empty())
+		return Found;
+
+	//Build anything the engine works out ahead of time now, while only this thread is using it
+	if (Engine == DSTARLITE || Engine == BIDIRECTIONAL || Engine == ARASTAR)
+		Engine = ASTAR;
+	if (Engine == FLOWFIELD)
+	{
+		int End = _Queries[0].second;
+		for (const pair<int, int>& Query : _Queries)
+		{
+			if (Query.second != End)
+				Engine = ASTAR;
+		}
+		if (Engine == FLOWFIELD && Paths.Field.GetGoal() != End)
+			Paths.Field.Build(End);
+	}
+	Paths.Prepare(Engine);
+
+	//Give every worker an even share of the queries to start with
+	int QueryCount = (int)_Queries.size();
+	int WorkerCount = (int)Workers.size();
+	for (int i = 0; i < WorkerCount; ++i)
+	{
+		std::lock_guard<std::mutex> Guard(Workers[i]->Lock);
+		Workers[i]->Next = (int)((long long)QueryCount * i / WorkerCount);
+		Workers[i]->End = (int)((long long)QueryCount * (i + 1) / WorkerCount);
+	}
+
+	{
+		std::lock_guard<std::mutex> Guard(Lock);
+		Queries = &_Queries;
+		Results = &Found;
+		BatchEngine = Engine;
+		BusyWorkers = WorkerCount;
+		++BatchNumber;
+	}
+	Wake.notify_all();
+
+	std::unique_lock<std::mutex> Guard(Lock);
+	Done.wait(Guard, [this] { return BusyWorkers == 0; });
+	Queries = nullptr;
+	Results = nullptr;
+	return Found;
+}
+
+int BatchSolver::TakeQuery(int WorkerIndex)
+{
+	Worker& Self = *Workers[WorkerIndex];
+	{
+		std::lock_guard<std::mutex> Guard(Self.Lock);
+		if (Self.Next < Self.End)
+			return Self.Next++;
+	}
+
+	//Out of work, so look for a worker that still has some, starting with the next one along
+	int WorkerCount = (int)Workers.size();
+	for (int i = 1; i < WorkerCount; ++i)
+	{
+		Worker& Victim = *Workers[(WorkerIndex + i) % WorkerCount];
+		int From, To;
+		{
+			std::lock_guard<std::mutex> Guard(Victim.Lock);
+			int Left = Victim.End - Victim.Next;
+			if (Left <= 0)
+				continue;
+
+			//Take the back half, rounding up so the last query can be stolen too
+			From = Victim.End - (Left + 1) / 2;
+			To = Victim.End;
+			Victim.End = From;
+		}
+
+		//Keep the rest of what was stolen so others can steal it back from here
+		std::lock_guard<std::mutex> Guard(Self.Lock);
+		Self.Next = From + 1;
+		Self.End = To;
+		return From;
+	}
+	return -1;
+}
+
+void BatchSolver::Run(int WorkerIndex)
+{
+	Worker& Self = *Workers[WorkerIndex];
+	unsigned Seen = 0;
+	while (true)
+	{
+		const vector<pair<int, int>>* Batch;
+		vector<CompactPath>* Found;
+		SearchEngine Engine;
+		{
+			std::unique_lock<std::mutex> Guard(Lock);
+			Wake.wait(Guard, [&] { return Stopping || BatchNumber != Seen; });
+			if (Stopping)
+				return;
+
+			Seen = BatchNumber;
+			Batch = Queries;
+			Found = Results;
+			Engine = BatchEngine;
+		}
+
+		for (int q = TakeQuery(WorkerIndex); q != -1; q = TakeQuery(WorkerIndex))
+		{
+			const pair<int, int>& Query = (*Batch)[q];
+			(*Found)[q].Pack(Paths.Map, Paths.FindPath(Self.Context, Engine, Query.first, Query.second));
+		}
+
+		std::lock_guard<std::mutex> Guard(Lock);
+		if (--BusyWorkers == 0)
+			Done.notify_one();
+	}
+}
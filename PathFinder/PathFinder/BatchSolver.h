@@ -0,0 +1,78 @@
+/**********************************************************
+* Description: Finds the paths for many start and end tiles on
+* the same map at once, spread over a pool of threads.
+*
+* Each worker thread keeps its own SearchContext for as long as
+* the pool lives, so a batch allocates nothing per search but
+* the paths themselves. A batch is split into one range of
+* queries per worker. A worker takes queries from the front of
+* its own range, and when that runs out it steals the back half
+* of another worker's range, so a worker that drew the slow
+* queries doesn't hold up the whole batch.
+*
+* Only one batch can run at a time, and the map must not
+* change while it is running. D* Lite and bidirectional A*
+* can only run one search at a time, so a batch asking for
+* either uses plain A* instead, which finds paths just as
+* short. So does a batch asking for the flow field unless every
+* query shares the same end tile, and a batch asking for ARA*,
+* whose paths can be longer than the shortest by a bound that a
+* CompactPath has no room for.
+**********************************************************/
+#pragma once
+#include <vector>
+#include <utility>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include "SearchContext.h"
+#include "PathSolver.h"
+#include "CompactPath.h"
+
+class BatchSolver
+{
+public:
+	//Start a pool of ThreadCount workers, or one for every core if ThreadCount is 0
+	BatchSolver(PathSolver& _Paths, int ThreadCount = 0);
+	~BatchSolver();
+
+	//Find the path for every (start, end) pair in Queries with the given engine.
+	//Blocks until the whole batch is done. Results are in the same order as Queries.
+	std::vector<CompactPath> FindPaths(const std::vector<std::pair<int, int>>& Queries, SearchEngine Engine);
+
+	int GetThreadCount() const { return (int)Workers.size(); }
+
+private:
+	struct Worker
+	{
+		std::thread Thread;
+		SearchContext Context;
+
+		//The queries this worker still has to do. Only used while Lock is held.
+		std::mutex Lock;
+		int Next = 0;
+		int End = 0;
+	};
+
+	void Run(int WorkerIndex);
+
+	//Take the next query for a worker, stealing one if its own range is empty. Returns -1 when there are none left.
+	int TakeQuery(int WorkerIndex);
+
+	PathSolver& Paths;
+	std::vector<std::unique_ptr<Worker>> Workers;
+
+	std::mutex Lock;
+	std::condition_variable Wake; //Workers wait here for a batch
+	std::condition_variable Done; //FindPaths waits here for the batch to finish
+
+	//The batch being worked on. Only changed while Lock is held and no worker is busy.
+	bool Stopping = false;
+	unsigned BatchNumber = 0;
+	int BusyWorkers = 0;
+	const std::vector<std::pair<int, int>>* Queries = nullptr;
+	std::vector<CompactPath>* Results = nullptr;
+	SearchEngine BatchEngine = ASTAR;
+};
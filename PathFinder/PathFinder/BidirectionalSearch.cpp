@@ -0,0 +1,204 @@
+#include "BidirectionalSearch.h"
+#include <algorithm>
+#include <cstdlib>
+using std::vector;
+
+//Path length and f value used before anything has been found
+const uint32_t NO_LENGTH = UINT32_MAX;
+
+BidirectionalSearch::~BidirectionalSearch()
+{
+	if (!Helper.joinable())
+		return;
+
+	{
+		std::lock_guard<std::mutex> Guard(Lock);
+		Stopping = true;
+	}
+	Wake.notify_one();
+	Helper.join();
+}
+
+int BidirectionalSearch::GetDistance(int a, int b) const
+{
+	return abs(Map.GetX(a) - Map.GetX(b)) + abs(Map.GetY(a) - Map.GetY(b));
+}
+
+vector<int> BidirectionalSearch::FindPath(SearchContext& Context, int Start, int End)
+{
+	if (Start == End)
+		return vector<int>(1, Start);
+
+	//The shared planes only need clearing when they are first made, or when the stamp runs out of values
+	if (PlaneSize != Map.Size() || ++Stamp == 0)
+	{
+		PlaneSize = Map.Size();
+		for (int i = 0; i < 2; ++i)
+			Reached[i].reset(new std::atomic<uint64_t>[PlaneSize]);
+		for (int t = 0; t < PlaneSize; ++t)
+		{
+			Reached[FORWARD][t].store(0, std::memory_order_relaxed);
+			Reached[BACKWARD][t].store(0, std::memory_order_relaxed);
+		}
+		Stamp = 1;
+	}
+
+	Contexts[FORWARD] = &Context;
+	Roots[FORWARD] = Start;
+	Roots[BACKWARD] = End;
+	Best = (uint64_t)NO_LENGTH << 32;
+	LowestF[FORWARD] = GetDistance(Start, End);
+	LowestF[BACKWARD] = GetDistance(Start, End);
+	Finished = false;
+
+	//Each side's root has to be visible to the other side before either starts, so a side that reaches the other root sees it
+	Reached[FORWARD][Start] = (uint64_t)Stamp << 32;
+	Reached[BACKWARD][End] = (uint64_t)Stamp << 32;
+
+	if (!Helper.joinable())
+		Helper = std::thread(&BidirectionalSearch::Run, this);
+	{
+		std::lock_guard<std::mutex> Guard(Lock);
+		BackwardPending = true;
+	}
+	Wake.notify_one();
+
+	Search(FORWARD);
+
+	{
+		std::unique_lock<std::mutex> Guard(Lock);
+		Done.wait(Guard, [this] { return !BackwardPending && !BackwardRunning; });
+	}
+
+	//The counts cover both sides. The open lists are separate, so the peak is the bigger of the two.
+	Context.Stats.Add(BackwardContext.Stats);
+
+	uint64_t Found = Best;
+	if ((uint32_t)(Found >> 32) == NO_LENGTH)
+		return vector<int>(); //Return empty path if it cannot be found
+
+	//Walk from the tile the searches met at back to the start tile, then on to the end tile
+	uint32_t Meet = (uint32_t)Found;
+	vector<int> Path;
+	for (uint32_t t = Meet; t != NO_PARENT; t = Context.Parent[t])
+		Path.push_back(t);
+	std::reverse(Path.begin(), Path.end());
+	for (uint32_t t = BackwardContext.Parent[Meet]; t != NO_PARENT; t = BackwardContext.Parent[t])
+		Path.push_back(t);
+	return Path;
+}
+
+void BidirectionalSearch::Run()
+{
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> Guard(Lock);
+			Wake.wait(Guard, [this] { return Stopping || BackwardPending; });
+			if (Stopping)
+				return;
+
+			BackwardPending = false;
+			BackwardRunning = true;
+		}
+
+		Search(BACKWARD);
+
+		{
+			std::lock_guard<std::mutex> Guard(Lock);
+			BackwardRunning = false;
+		}
+		Done.notify_one();
+	}
+}
+
+void BidirectionalSearch::Search(int SideIndex)
+{
+	SearchContext& Context = *Contexts[SideIndex];
+	IndexedHeap& Open = Context.OpenList;
+	std::atomic<uint64_t>* Mine = Reached[SideIndex].get();
+	std::atomic<uint64_t>* Theirs = Reached[1 - SideIndex].get();
+	int Root = Roots[SideIndex];
+	int Target = Roots[1 - SideIndex];
+	uint64_t StampBits = (uint64_t)Stamp << 32;
+
+	Context.BeginSearch(Map.Size());
+	Open.Clear();
+	Context.Touch(Root);
+	Context.G[Root] = 0;
+	Open.Push(Root, GetDistance(Root, Target), GetDistance(Root, Target));
+	Context.Stats.CountPush(Open.Size());
+	Context.List[Root] = OPENED;
+
+	while (!Open.Empty() && !Finished.load(std::memory_order_relaxed))
+	{
+		int Current = Open.Pop();
+		Context.List[Current] = CLOSED;
+		++Context.Stats.Expanded;
+
+		//The tiles still on the open list have f values at least this big, so once this tile can't lead
+		//to a shorter path none of them can either, and this side is done
+		int64_t Length = (int64_t)(Best.load() >> 32);
+		int64_t G = Context.G[Current];
+		if (G + GetDistance(Current, Target) >= Length)
+			break;
+
+		//Skip the tile when the other side shows that every path through it is too long.
+		//The other side's open tiles are all at least its lowest f value, and that bounds what is left of a path through here.
+		if (G + LowestF[1 - SideIndex].load() - GetDistance(Current, Root) < Length)
+		{
+			int x = Map.GetX(Current);
+			int y = Map.GetY(Current);
+			int Neighbors[4];
+			int NeighborCount = 0;
+			if (y > 0) Neighbors[NeighborCount++] = Current - Map.Width;
+			if (y < Map.Height - 1) Neighbors[NeighborCount++] = Current + Map.Width;
+			if (x > 0) Neighbors[NeighborCount++] = Current - 1;
+			if (x < Map.Width - 1) Neighbors[NeighborCount++] = Current + 1;
+
+			for (int i = 0; i < NeighborCount; ++i)
+			{
+				int t = Neighbors[i];
+				if (Map.State[t] == BLOCKED)
+					continue;
+
+				Context.Touch(t);
+				uint32_t NewG = Context.G[Current] + 1;
+				if (Context.List[t] == CLOSED || NewG >= Context.G[t])
+					continue;
+
+				int NewH = GetDistance(t, Target);
+				Context.G[t] = NewG;
+				Context.Parent[t] = Current;
+				if (Context.List[t] == OPENED)
+				{
+					Open.DecreaseKey(t, NewG + NewH, NewH);
+				}
+				else
+				{
+					Open.Push(t, NewG + NewH, NewH);
+					Context.Stats.CountPush(Open.Size());
+					Context.List[t] = OPENED;
+				}
+
+				//Tell the other side about the tile before looking at what it knows. If both sides reach
+				//the tile at once, at least one of them is then sure to see the other's distance.
+				Mine[t].store(StampBits | NewG);
+				uint64_t Other = Theirs[t].load();
+				if ((Other & ~(uint64_t)UINT32_MAX) != StampBits)
+					continue;
+
+				uint64_t Candidate = ((uint64_t)(NewG + (uint32_t)Other) << 32) | (uint32_t)t;
+				uint64_t Shortest = Best.load();
+				while ((Candidate >> 32) < (Shortest >> 32) && !Best.compare_exchange_weak(Shortest, Candidate))
+				{
+				}
+			}
+		}
+
+		LowestF[SideIndex] = Open.Empty() ? NO_LENGTH : (uint32_t)(Open.TopPriority() >> 32);
+	}
+
+	//Once either side has run out of tiles, the shortest path found so far can't be beaten
+	Finished = true;
+}
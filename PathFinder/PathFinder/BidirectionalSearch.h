@@ -0,0 +1,88 @@
+/**********************************************************
+* Description: Bidirectional A* with the two searches running
+* at the same time, one from the start tile on the calling
+* thread and one from the end tile on a helper thread.
+*
+* This follows the pruning of PNBA* (Rios and Chaimowicz).
+* Whenever a search finds a shorter way to a tile the other
+* search has reached, the two distances together give a path,
+* and the shortest one so far is kept. A search throws away a
+* tile it takes off its open list, instead of expanding it,
+* when no path through it can beat the shortest path found so
+* far. It judges this with its own heuristic, and with the
+* lowest f value on the other search's open list, which only
+* ever goes up, so reading an old value is always safe. As soon
+* as either open list runs out, or has nothing left that could
+* lead to a shorter path, the shortest path so far is the
+* shortest path there is.
+*
+* Unlike PNBA*, a search never skips a tile because the other
+* search has already closed it. When both searches run at the
+* same time that can hide the meeting point of the shortest
+* path, so each search keeps its own closed tiles.
+*
+* The searches share their distances through atomic planes.
+* The planes are stamped with the search that wrote them, so
+* nothing has to be cleared between searches.
+*
+* The helper thread and the shared planes belong to the
+* object, so only one search can run at a time.
+**********************************************************/
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include "TileMap.h"
+#include "SearchContext.h"
+
+class BidirectionalSearch
+{
+public:
+	BidirectionalSearch(const TileMap& _Map) : Map(_Map) {}
+	~BidirectionalSearch();
+
+	//Find the shortest path from Start to End. The search from the start tile uses Context,
+	//the one from the end tile uses a context of its own.
+	std::vector<int> FindPath(SearchContext& Context, int Start, int End);
+
+private:
+	enum Side
+	{
+		FORWARD = 0, //Searches from the start tile toward the end tile
+		BACKWARD //Searches from the end tile toward the start tile
+	};
+
+	//Run one side's search until it or the other side runs out of tiles
+	void Search(int SideIndex);
+
+	//The helper thread, which runs the backward search whenever FindPath asks for it
+	void Run();
+
+	int GetDistance(int a, int b) const;
+
+	const TileMap& Map;
+	SearchContext BackwardContext;
+	SearchContext* Contexts[2] = { nullptr, &BackwardContext };
+	int Roots[2] = { -1, -1 }; //The tile each side starts from, which is what the other side is heading for
+
+	//Shared by both sides while a search runs
+	std::unique_ptr<std::atomic<uint64_t>[]> Reached[2]; //Stamp in the high half, the side's distance to the tile in the low half
+	int PlaneSize = 0;
+	uint32_t Stamp = 0;
+	std::atomic<uint64_t> Best; //Length of the shortest path found in the high half, the tile the two sides met at in the low half
+	std::atomic<uint32_t> LowestF[2]; //Smallest f value on each side's open list
+	std::atomic<bool> Finished;
+
+	//Hands the backward search to the helper thread. Only used while Lock is held.
+	std::thread Helper;
+	std::mutex Lock;
+	std::condition_variable Wake;
+	std::condition_variable Done;
+	bool Stopping = false;
+	bool BackwardPending = false;
+	bool BackwardRunning = false;
+};
@@ -0,0 +1,217 @@
+#include "BitboardSearch.h"
+#include <algorithm>
+#include <cstdlib>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#define AVX2_FUNCTION
+#elif defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define AVX2_FUNCTION __attribute__((target("avx2")))
+#endif
+using std::vector;
+
+static bool CpuHasAvx2()
+{
+#if defined(_MSC_VER)
+	int Info[4];
+	__cpuidex(Info, 7, 0);
+	return (Info[1] & (1 << 5)) != 0;
+#elif defined(__x86_64__) || defined(__i386__)
+	return __builtin_cpu_supports("avx2");
+#else
+	return false;
+#endif
+}
+
+void BitboardSearch::Build()
+{
+	WordsPerRow = (Map.Width + 63) / 64;
+	Stride = WordsPerRow + 2;
+	int WordCount = (Map.Height + 2) * Stride;
+
+	Free.assign(WordCount, 0);
+	for (int y = 0; y < Map.Height; ++y)
+	{
+		for (int x = 0; x < Map.Width; ++x)
+		{
+			if (Map.State[Map.GetIndex(x, y)] != BLOCKED)
+				Free[GetWord(x, y)] |= GetBit(x);
+		}
+	}
+
+	//Rows shorter than four words don't fill a single AVX2 register
+	Avx2 = WordsPerRow >= 4 && CpuHasAvx2();
+	Built = true;
+}
+
+void BitboardSearch::TileChanged(int Index)
+{
+	if (!Built)
+		return;
+
+	int x = Map.GetX(Index);
+	int y = Map.GetY(Index);
+	if (Map.State[Index] == BLOCKED)
+		Free[GetWord(x, y)] &= ~GetBit(x);
+	else
+		Free[GetWord(x, y)] |= GetBit(x);
+}
+
+bool BitboardSearch::Grow(Wave& v, int First, int Last) const
+{
+	const uint64_t* f = v.Frontier.data();
+	uint64_t* n = v.Next.data();
+	uint64_t* u = v.Unreached.data();
+	for (int y = First; y <= Last; ++y)
+	{
+		int Word = GetWord(0, y);
+		for (int w = 0; w < WordsPerRow; ++w, ++Word)
+		{
+			uint64_t Left = (f[Word] << 1) | (f[Word - 1] >> 63); //Tiles to the right of a frontier tile
+			uint64_t Right = (f[Word] >> 1) | (f[Word + 1] << 63); //Tiles to the left of a frontier tile
+			uint64_t Bits = (Left | Right | f[Word - Stride] | f[Word + Stride]) & u[Word];
+			n[Word] = Bits;
+			u[Word] &= ~Bits;
+			v.RecordWord(Word, Bits);
+		}
+	}
+	return v.LayerEnd > v.LayerStart.back();
+}
+
+#ifdef AVX2_FUNCTION
+AVX2_FUNCTION bool BitboardSearch::GrowAvx2(Wave& v, int First, int Last) const
+{
+	const uint64_t* f = v.Frontier.data();
+	uint64_t* n = v.Next.data();
+	uint64_t* u = v.Unreached.data();
+	for (int y = First; y <= Last; ++y)
+	{
+		int Word = GetWord(0, y);
+		int w = 0;
+		for (; w + 4 <= WordsPerRow; w += 4, Word += 4)
+		{
+			__m256i Center = _mm256_loadu_si256((const __m256i*)(f + Word));
+			__m256i Before = _mm256_loadu_si256((const __m256i*)(f + Word - 1));
+			__m256i After = _mm256_loadu_si256((const __m256i*)(f + Word + 1));
+			__m256i Above = _mm256_loadu_si256((const __m256i*)(f + Word - Stride));
+			__m256i Below = _mm256_loadu_si256((const __m256i*)(f + Word + Stride));
+			__m256i Open = _mm256_loadu_si256((const __m256i*)(u + Word));
+
+			__m256i Left = _mm256_or_si256(_mm256_slli_epi64(Center, 1), _mm256_srli_epi64(Before, 63));
+			__m256i Right = _mm256_or_si256(_mm256_srli_epi64(Center, 1), _mm256_slli_epi64(After, 63));
+			__m256i Bits = _mm256_and_si256(_mm256_or_si256(_mm256_or_si256(Left, Right), _mm256_or_si256(Above, Below)), Open);
+			_mm256_storeu_si256((__m256i*)(n + Word), Bits);
+			if (_mm256_testz_si256(Bits, Bits))
+				continue;
+
+			_mm256_storeu_si256((__m256i*)(u + Word), _mm256_andnot_si256(Bits, Open));
+			for (int i = 0; i < 4; ++i)
+				v.RecordWord(Word + i, n[Word + i]);
+		}
+
+		//The words left over at the end of the row
+		for (; w < WordsPerRow; ++w, ++Word)
+		{
+			uint64_t Left = (f[Word] << 1) | (f[Word - 1] >> 63);
+			uint64_t Right = (f[Word] >> 1) | (f[Word + 1] << 63);
+			uint64_t Bits = (Left | Right | f[Word - Stride] | f[Word + Stride]) & u[Word];
+			n[Word] = Bits;
+			u[Word] &= ~Bits;
+			v.RecordWord(Word, Bits);
+		}
+	}
+	return v.LayerEnd > v.LayerStart.back();
+}
+#else
+bool BitboardSearch::GrowAvx2(Wave& v, int First, int Last) const
+{
+	return Grow(v, First, Last);
+}
+#endif
+
+bool BitboardSearch::InLayer(const Wave& v, int Layer, int x, int y) const
+{
+	if (x < 0 || y < 0 || x >= Map.Width || y >= Map.Height)
+		return false;
+
+	//The words of a layer are in order, so the word can be found with a binary search
+	int Word = GetWord(x, y);
+	auto Begin = v.LayerWords.begin() + v.LayerStart[Layer];
+	auto End = v.LayerWords.begin() + v.LayerStart[Layer + 1];
+	auto Found = std::lower_bound(Begin, End, Word);
+	return Found != End && *Found == Word && (v.LayerBits[Found - v.LayerWords.begin()] & GetBit(x)) != 0;
+}
+
+vector<int> BitboardSearch::FindPath(SearchContext& Context, int Start, int End)
+{
+	if (!Built)
+		Build();
+
+	Wave v = { Context.Unreached, Context.Frontier, Context.NextFrontier, Context.LayerStart, Context.LayerWords, Context.LayerBits, 0 };
+	int WordCount = (int)Free.size();
+	v.Unreached = Free;
+	v.Frontier.assign(WordCount, 0);
+	v.Next.assign(WordCount, 0);
+	if ((int)v.LayerWords.size() < Map.Size() + 1)
+		v.LayerWords.resize(Map.Size() + 1);
+	if ((int)v.LayerBits.size() < Map.Size() + 1)
+		v.LayerBits.resize(Map.Size() + 1);
+
+	int EndX = Map.GetX(End);
+	int EndY = Map.GetY(End);
+	int EndWord = GetWord(EndX, EndY);
+	uint64_t EndBit = GetBit(EndX);
+
+	//The frontier starts out as just the start tile
+	int StartX = Map.GetX(Start);
+	int StartY = Map.GetY(Start);
+	v.Frontier[GetWord(StartX, StartY)] = GetBit(StartX);
+	v.Unreached[GetWord(StartX, StartY)] &= ~GetBit(StartX);
+
+	v.LayerStart.assign(1, 0);
+	v.RecordWord(GetWord(StartX, StartY), GetBit(StartX));
+	v.LayerStart.push_back(v.LayerEnd);
+
+	//Only the rows around the frontier can change, so that is all each step looks at
+	int First = StartY;
+	int Last = StartY;
+	bool Found = Start == End;
+	while (!Found)
+	{
+		int GrowFirst = std::max(First - 1, 0);
+		int GrowLast = std::min(Last + 1, Map.Height - 1);
+		bool Grown = Avx2 ? GrowAvx2(v, GrowFirst, GrowLast) : Grow(v, GrowFirst, GrowLast);
+		if (!Grown)
+			return vector<int>(); //Return empty path if it cannot be found
+		v.LayerStart.push_back(v.LayerEnd);
+		Found = (v.Next[EndWord] & EndBit) != 0;
+
+		//The next frontier only has tiles in the rows between the first and last words of the new layer
+		int NextFirst = v.LayerWords[v.LayerStart[v.LayerStart.size() - 2]] / Stride - 1;
+		int NextLast = v.LayerWords[v.LayerEnd - 1] / Stride - 1;
+
+		//The new layer becomes the frontier. The rows of the old frontier are cleared so they can hold the layer after.
+		for (int y = First; y <= Last; ++y)
+			std::fill(v.Frontier.begin() + GetWord(0, y), v.Frontier.begin() + GetWord(0, y) + WordsPerRow, 0);
+		v.Frontier.swap(v.Next);
+		First = NextFirst;
+		Last = NextLast;
+	}
+
+	//Walk back from the end tile, each step going to a neighbor one layer closer to the start
+	int Layers = (int)v.LayerStart.size() - 1;
+	vector<int> Path(Layers);
+	int x = EndX;
+	int y = EndY;
+	Path[Layers - 1] = End;
+	for (int Layer = Layers - 2; Layer >= 0; --Layer)
+	{
+		if (InLayer(v, Layer, x, y - 1)) --y;
+		else if (InLayer(v, Layer, x, y + 1)) ++y;
+		else if (InLayer(v, Layer, x - 1, y)) --x;
+		else ++x;
+		Path[Layer] = Map.GetIndex(x, y);
+	}
+	return Path;
+}
@@ -0,0 +1,91 @@
+/**********************************************************
+* Description: Breadth first search done 64 tiles at a time.
+*
+* Every row of the map is kept as a row of bits, one bit per
+* tile, set where the tile isn't blocked. The frontier of the
+* search is kept the same way, so one step of the search is a
+* few shifts, ORs and ANDs per 64 tiles: a tile joins the next
+* frontier when a tile to its left, right, above or below is in
+* the current frontier and it is empty and not yet reached.
+*
+* Each frontier (layer) is recorded, and the path is walked
+* back from the end tile by stepping to any neighbor in the
+* layer before. Every step costs the same, so the path is
+* always a shortest one.
+*
+* Rows wider than 64 tiles span several words. Where the CPU
+* supports AVX2 and rows are at least four words long, four
+* words are grown at once.
+**********************************************************/
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "TileMap.h"
+#include "SearchContext.h"
+
+class BitboardSearch
+{
+public:
+	BitboardSearch(const TileMap& _Map) : Map(_Map) {}
+
+	//Turn the whole map into rows of bits
+	void Build();
+
+	//Update the bits after a tile switched between blocked and not blocked
+	void TileChanged(int Index);
+
+	//Find the shortest path from Start to End, building the bits first if they haven't been built yet.
+	//Searches from several threads at once need the bits to have been built already.
+	std::vector<int> FindPath(SearchContext& Context, int Start, int End);
+
+	bool IsBuilt() const { return Built; }
+
+	//Whether the four word at a time version is being used
+	bool UsesAvx2() const { return Avx2; }
+
+private:
+	//The state of one search, all of it kept in the search's context
+	struct Wave
+	{
+		std::vector<uint64_t>& Unreached; //Tiles that are free and the search hasn't reached yet
+		std::vector<uint64_t>& Frontier;
+		std::vector<uint64_t>& Next;
+
+		//Every layer of the search, keeping only the words that have a bit set.
+		//Layer i is LayerWords and LayerBits from LayerStart[i] to LayerStart[i + 1], in word order.
+		//Every kept word has a tile no earlier layer has, so there is room for one word per tile.
+		std::vector<int>& LayerStart;
+		std::vector<int>& LayerWords;
+		std::vector<uint64_t>& LayerBits;
+		int LayerEnd; //Number of words recorded so far
+
+		//Add a word to the layer being recorded. Words without any bits are written but not kept.
+		void RecordWord(int Word, uint64_t Bits)
+		{
+			LayerWords[LayerEnd] = Word;
+			LayerBits[LayerEnd] = Bits;
+			LayerEnd += Bits != 0;
+		}
+	};
+
+	//Rows are stored with an empty word on each side and an empty row above and below the map,
+	//so the neighbors of every word can be read without checking the edges
+	int GetWord(int x, int y) const { return (y + 1) * Stride + 1 + x / 64; }
+	static uint64_t GetBit(int x) { return (uint64_t)1 << (x % 64); }
+
+	//Fill the rows First to Last of Next with the tiles next to Frontier that are still in Unreached,
+	//take them out of Unreached and record them as a new layer. Returns false if nothing new was reached.
+	bool Grow(Wave& w, int First, int Last) const;
+	bool GrowAvx2(Wave& w, int First, int Last) const;
+
+	//True if the tile at x, y is in the given recorded layer
+	bool InLayer(const Wave& w, int Layer, int x, int y) const;
+
+	const TileMap& Map;
+	bool Built = false;
+	bool Avx2 = false;
+	int WordsPerRow = 0;
+	int Stride = 0; //Words per row including the empty word on each side
+
+	std::vector<uint64_t> Free; //Bits of the tiles that aren't blocked
+};
@@ -0,0 +1,63 @@
+#include "BucketQueue.h"
+using std::vector;
+
+void BucketQueue::Push(int Index, int Key, int)
+{
+	if (Count == 0)
+	{
+		Lowest = Key;
+		Highest = Key;
+	}
+
+	int Low = Key < Lowest ? Key : Lowest;
+	int High = Key > Highest ? Key : Highest;
+	if (High - Low >= (int)Buckets.size())
+		Grow(Low, High);
+
+	Lowest = Low;
+	Highest = High;
+	Buckets[Key & (Buckets.size() - 1)].push_back(Index);
+	++Count;
+}
+
+int BucketQueue::Pop()
+{
+	int Mask = (int)Buckets.size() - 1;
+	while (Buckets[Lowest & Mask].empty())
+		++Lowest;
+
+	vector<int>& Bucket = Buckets[Lowest & Mask];
+	int Index = Bucket.back();
+	Bucket.pop_back();
+	--Count;
+	return Index;
+}
+
+void BucketQueue::Clear()
+{
+	if (Count > 0)
+	{
+		int Mask = (int)Buckets.size() - 1;
+		for (int Key = Lowest; Key <= Highest; ++Key)
+			Buckets[Key & Mask].clear();
+	}
+	Count = 0;
+	Stale = 0;
+}
+
+void BucketQueue::Grow(int Low, int High)
+{
+	int NewSize = (int)Buckets.size();
+	while (NewSize <= High - Low)
+		NewSize *= 2;
+
+	//Move the buckets in use to their place in the bigger ring, keeping the order inside each bucket
+	vector<vector<int>> NewBuckets(NewSize);
+	if (Count > 0)
+	{
+		int OldMask = (int)Buckets.size() - 1;
+		for (int Key = Lowest; Key <= Highest; ++Key)
+			NewBuckets[Key & (NewSize - 1)].swap(Buckets[Key & OldMask]);
+	}
+	Buckets.swap(NewBuckets);
+}
@@ -0,0 +1,62 @@
+/**********************************************************
+* Description: A bucket queue (Dial's algorithm) for A*.
+*
+* Every step costs 1 and the heuristic is a whole number, so f
+* values are small integers, and with a consistent heuristic
+* the f values in the open list are never more than a few
+* apart. Each f value gets its own bucket in a small ring, so
+* pushing and popping never compare anything.
+*
+* Tiles in the same bucket come out last in, first out, which
+* favours the tiles reached most recently, i.e. the deepest.
+*
+* The queue can't move a tile to another bucket, so a tile
+* whose f value drops is pushed again and the old entry stays
+* behind. The search has to skip tiles it has already closed
+* when they are popped a second time, and tell the queue with
+* SkipStale, so Size can count only the entries that are still
+* live.
+**********************************************************/
+#pragma once
+#include <vector>
+
+class BucketQueue
+{
+public:
+	BucketQueue() : Buckets(8) {}
+
+	bool Empty() const { return Count == 0; }
+
+	//Tiles in the queue, not counting the old entries of tiles that were pushed again
+	int Size() const { return Count - Stale; }
+
+	//Add a tile with the given f value. The tie break is only there to match IndexedHeap;
+	//ties always go to the tile pushed last.
+	void Push(int Index, int Key, int TieBreak = 0);
+
+	//A tile that is already in the queue is simply pushed again with its new f value, and its old entry goes stale
+	void DecreaseKey(int Index, int Key, int TieBreak = 0)
+	{
+		Push(Index, Key, TieBreak);
+		++Stale;
+	}
+
+	//Called when Pop returned the old entry of a tile the search had already taken
+	void SkipStale() { --Stale; }
+
+	//Remove and return a tile with the smallest f value
+	int Pop();
+
+	//Remove every tile. Only touches the buckets that are in use.
+	void Clear();
+
+private:
+	//Make the ring big enough to hold every f value from Low to High
+	void Grow(int Low, int High);
+
+	std::vector<std::vector<int>> Buckets; //Ring of buckets. f value k lives in Buckets[k & (Buckets.size() - 1)].
+	int Lowest = 0; //No bucket below this f value has anything in it
+	int Highest = 0; //No bucket above this f value has anything in it
+	int Count = 0; //Entries in the buckets, stale or not
+	int Stale = 0; //Entries left behind by DecreaseKey that haven't been popped yet
+};
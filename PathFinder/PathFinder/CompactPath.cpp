@@ -0,0 +1,43 @@
+#include "CompactPath.h"
+#include <cstdlib>
+using std::vector;
+
+//The moves in the order of their 2 bit codes: up, down, left, right
+enum Move : uint8_t
+{
+	UP = 0,
+	DOWN,
+	LEFT,
+	RIGHT
+};
+
+void CompactPath::Pack(const TileMap& Map, const vector<int>& Path)
+{
+	Moves.assign((Path.size() + 2) / 4, 0);
+	Length = (int)Path.size();
+	Start = Path.empty() ? -1 : Path[0];
+
+	for (size_t i = 1; i < Path.size(); ++i)
+	{
+		int Step = Path[i] - Path[i - 1];
+		uint8_t Code = Step == -Map.Width ? UP : Step == Map.Width ? DOWN : Step == -1 ? LEFT : RIGHT;
+		Moves[(i - 1) / 4] |= Code << ((i - 1) % 4 * 2);
+	}
+}
+
+vector<int> CompactPath::Unpack(const TileMap& Map) const
+{
+	vector<int> Path;
+	if (Empty())
+		return Path;
+
+	int Steps[4] = { -Map.Width, Map.Width, -1, 1 };
+	Path.reserve(Length);
+	Path.push_back(Start);
+	for (int i = 1; i < Length; ++i)
+	{
+		int Code = (Moves[(i - 1) / 4] >> ((i - 1) % 4 * 2)) & 3;
+		Path.push_back(Path.back() + Steps[Code]);
+	}
+	return Path;
+}
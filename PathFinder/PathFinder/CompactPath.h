@@ -0,0 +1,30 @@
+/**********************************************************
+* Description: A path stored as moves instead of tiles.
+*
+* Every step of a path goes to one of the four tiles next to
+* the last one, so a step fits in 2 bits and four steps fit in
+* a byte. Only the start tile is stored as an index. A path of
+* n tiles takes n / 4 bytes instead of 4n, which matters when
+* thousands of paths are kept at once.
+**********************************************************/
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "TileMap.h"
+
+class CompactPath
+{
+public:
+	//Pack a path of tiles that are each next to the one before
+	void Pack(const TileMap& Map, const std::vector<int>& Path);
+
+	//The path as tile indices again
+	std::vector<int> Unpack(const TileMap& Map) const;
+
+	bool Empty() const { return Start == -1; }
+	int Size() const { return Length; } //Number of tiles in the path, counting the start tile
+
+	int Start = -1; //First tile of the path, or -1 if there is no path
+	int Length = 0;
+	std::vector<uint8_t> Moves; //2 bits a step, the first step in the lowest bits
+};
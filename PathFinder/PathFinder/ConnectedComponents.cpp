@@ -0,0 +1,215 @@
+#include "ConnectedComponents.h"
+#include <cstdlib>
+using std::vector;
+
+void ConnectedComponents::Build()
+{
+	Labels.assign(Map.Size(), -1);
+	Sizes.clear();
+	FreeLabels.clear();
+	Visited.assign(Map.Size(), 0);
+	Owner.assign(Map.Size(), 0);
+	VisitStamp = 0;
+
+	for (int i = 0; i < Map.Size(); ++i)
+	{
+		if (Map.State[i] != BLOCKED && Labels[i] == -1)
+			Flood(i, NewLabel());
+	}
+	Built = true;
+}
+
+int ConnectedComponents::NewLabel()
+{
+	if (!FreeLabels.empty())
+	{
+		int Label = FreeLabels.back();
+		FreeLabels.pop_back();
+		return Label;
+	}
+	Sizes.push_back(0);
+	return (int)Sizes.size() - 1;
+}
+
+void ConnectedComponents::Flood(int Index, int Label)
+{
+	int OldLabel = Labels[Index];
+	Queue.clear();
+	Queue.push_back(Index);
+	Labels[Index] = Label;
+
+	for (size_t Head = 0; Head < Queue.size(); ++Head)
+	{
+		int Neighbors[4];
+		int Count = Map.GetNeighbors(Queue[Head], Neighbors);
+		for (int i = 0; i < Count; ++i)
+		{
+			int t = Neighbors[i];
+			if (Labels[t] == OldLabel)
+			{
+				Labels[t] = Label;
+				Queue.push_back(t);
+			}
+		}
+	}
+
+	if (OldLabel != -1)
+	{
+		Sizes[OldLabel] -= (int)Queue.size();
+		if (Sizes[OldLabel] == 0)
+			FreeLabels.push_back(OldLabel);
+	}
+	Sizes[Label] += (int)Queue.size();
+}
+
+void ConnectedComponents::TileChanged(int Index)
+{
+	if (!Built)
+		return;
+
+	if (Map.State[Index] == BLOCKED)
+	{
+		if (Labels[Index] != -1)
+			Split(Index);
+	}
+	else if (Labels[Index] == -1)
+	{
+		Join(Index);
+	}
+}
+
+void ConnectedComponents::Join(int Index)
+{
+	int Neighbors[4];
+	int Count = Map.GetNeighbors(Index, Neighbors);
+
+	//The new tile joins the biggest area next to it, and every other area next to it is relabeled into that one
+	int Biggest = -1;
+	for (int i = 0; i < Count; ++i)
+	{
+		int Label = Labels[Neighbors[i]];
+		if (Biggest == -1 || Sizes[Label] > Sizes[Biggest])
+			Biggest = Label;
+	}
+
+	if (Biggest == -1)
+		Biggest = NewLabel();
+
+	Labels[Index] = Biggest;
+	++Sizes[Biggest];
+
+	for (int i = 0; i < Count; ++i)
+	{
+		if (Labels[Neighbors[i]] != Biggest)
+			Flood(Neighbors[i], Biggest);
+	}
+}
+
+void ConnectedComponents::Split(int Index)
+{
+	int Label = Labels[Index];
+	Labels[Index] = -1;
+	if (--Sizes[Label] == 0)
+	{
+		FreeLabels.push_back(Label);
+		return;
+	}
+
+	int Neighbors[4];
+	int Count = Map.GetNeighbors(Index, Neighbors);
+	if (Count < 2)
+		return;
+
+	if (++VisitStamp == 0)
+	{
+		Visited.assign(Map.Size(), 0);
+		VisitStamp = 1;
+	}
+
+	//One breadth first search per neighbor, taking turns one tile at a time.
+	//Group[i] is the search that search i has met and joined, like a tiny union-find.
+	size_t Heads[4] = {};
+	int Group[4];
+	for (int i = 0; i < Count; ++i)
+	{
+		Group[i] = i;
+		SplitQueues[i].clear();
+		SplitQueues[i].push_back(Neighbors[i]);
+		Visited[Neighbors[i]] = VisitStamp;
+		Owner[Neighbors[i]] = (uint8_t)i;
+	}
+
+	auto Find = [&](int i)
+	{
+		while (Group[i] != i)
+			i = Group[i];
+		return i;
+	};
+
+	bool Done[4] = {}; //Groups that were found to be cut off from the rest
+	int Remaining = Count; //Groups that are neither joined to another one nor cut off
+
+	//A group that runs out of tiles while another group is still going is cut off
+	auto IsExhausted = [&](int g)
+	{
+		for (int i = 0; i < Count; ++i)
+		{
+			if (Find(i) == g && Heads[i] < SplitQueues[i].size())
+				return false;
+		}
+		return true;
+	};
+
+	while (Remaining > 1)
+	{
+		for (int i = 0; i < Count && Remaining > 1; ++i)
+		{
+			if (Done[Find(i)] || Heads[i] >= SplitQueues[i].size())
+				continue;
+
+			int Neighbors2[4];
+			int Count2 = Map.GetNeighbors(SplitQueues[i][Heads[i]++], Neighbors2);
+			for (int n = 0; n < Count2; ++n)
+			{
+				int t = Neighbors2[n];
+				if (Visited[t] != VisitStamp)
+				{
+					Visited[t] = VisitStamp;
+					Owner[t] = (uint8_t)i;
+					SplitQueues[i].push_back(t);
+				}
+				else
+				{
+					int a = Find(i);
+					int b = Find(Owner[t]);
+					if (a != b)
+					{
+						Group[b] = a;
+						--Remaining;
+					}
+				}
+			}
+		}
+
+		for (int i = 0; i < Count && Remaining > 1; ++i)
+		{
+			int g = Find(i);
+			if (g != i || Done[g] || !IsExhausted(g))
+				continue;
+
+			//Every tile this group reached is cut off from the others, so it becomes a new area
+			Done[g] = true;
+			--Remaining;
+			int NewComponent = NewLabel();
+			for (int j = 0; j < Count; ++j)
+			{
+				if (Find(j) != g)
+					continue;
+				for (int t : SplitQueues[j])
+					Labels[t] = NewComponent;
+				Sizes[NewComponent] += (int)SplitQueues[j].size();
+				Sizes[Label] -= (int)SplitQueues[j].size();
+			}
+		}
+	}
+}
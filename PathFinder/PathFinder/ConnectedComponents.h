@@ -0,0 +1,62 @@
+/**********************************************************
+* Description: Labels every tile that isn't blocked with the
+* connected area (component) it belongs to. Two tiles are
+* joined by a path exactly when they have the same label, so
+* a search whose start and end tiles carry different labels
+* can be turned down without expanding anything.
+*
+* The labels are kept up to date one tile at a time. Clearing
+* a tile can only join the areas around it, and the smaller
+* areas are relabeled into the biggest one. Blocking a tile
+* can split its area, so a search runs outward from each of its
+* neighbors at the same pace. Searches that meet belong to the
+* same piece. A piece whose searches run out of tiles first is
+* cut off and gets a new label, so only the smaller pieces are
+* ever walked.
+**********************************************************/
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "TileMap.h"
+
+class ConnectedComponents
+{
+public:
+	ConnectedComponents(const TileMap& _Map) : Map(_Map) {}
+
+	//Label the whole map from scratch
+	void Build();
+
+	//Update the labels after a tile switched between blocked and not blocked
+	void TileChanged(int Index);
+
+	//True when a path between the two tiles exists. Neither tile may be blocked.
+	bool Connected(int a, int b) const { return Labels[a] == Labels[b]; }
+
+	//Label of a tile, or -1 if it is blocked
+	int GetLabel(int Index) const { return Labels[Index]; }
+
+	bool IsBuilt() const { return Built; }
+
+private:
+	int NewLabel();
+
+	//Give every tile that is reachable from Index the label Label
+	void Flood(int Index, int Label);
+
+	void Join(int Index);
+	void Split(int Index);
+
+	const TileMap& Map;
+	bool Built = false;
+	std::vector<int> Labels; //Component of each tile, or -1 if it is blocked
+	std::vector<int> Sizes; //Number of tiles with each label
+	std::vector<int> FreeLabels; //Labels no tile uses anymore
+
+	//Scratch space for the searches after a tile is blocked
+	std::vector<uint32_t> Visited; //The split that last reached each tile
+	std::vector<uint8_t> Owner; //Which neighbor's search reached each tile first
+	uint32_t VisitStamp = 0;
+	std::vector<int> Queue;
+	std::vector<int> SplitQueues[4]; //One search per neighbor of the blocked tile
+};
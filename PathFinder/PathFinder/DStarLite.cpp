@@ -0,0 +1,157 @@
+#include "DStarLite.h"
+#include <algorithm>
+using std::vector;
+
+static const int INFINITE_COST = INT32_MAX; //g and rhs of a tile that can't reach the end tile
+
+void DStarLite::CalculateKey(int Index, int& Key, int& TieBreak) const
+{
+	int Best = std::min(G[Index], Rhs[Index]);
+	TieBreak = Best;
+	Key = Best == INFINITE_COST ? INFINITE_COST : Best + GetDistance(StartTile, Index) + KeyModifier;
+}
+
+void DStarLite::Initialize(int End)
+{
+	G.assign(Map.Size(), INFINITE_COST);
+	Rhs.assign(Map.Size(), INFINITE_COST);
+	Queue.Resize(Map.Size());
+	KeyModifier = 0;
+	EndTile = End;
+
+	Rhs[EndTile] = 0;
+	int Key, TieBreak;
+	CalculateKey(EndTile, Key, TieBreak);
+	Queue.Push(EndTile, Key, TieBreak);
+	Initialized = true;
+}
+
+void DStarLite::UpdateTile(int Index)
+{
+	//A tile's rhs is one more than its best neighbor. Blocked tiles can't be reached at all.
+	if (Index != EndTile)
+	{
+		int Best = INFINITE_COST;
+		if (Map.State[Index] != BLOCKED)
+		{
+			int Neighbors[4];
+			int Count = Map.GetNeighbors(Index, Neighbors);
+			for (int i = 0; i < Count; ++i)
+			{
+				if (G[Neighbors[i]] != INFINITE_COST)
+					Best = std::min(Best, G[Neighbors[i]] + 1);
+			}
+		}
+		Rhs[Index] = Best;
+	}
+
+	//Only tiles whose g and rhs disagree need to be in the queue
+	if (G[Index] != Rhs[Index])
+	{
+		int Key, TieBreak;
+		CalculateKey(Index, Key, TieBreak);
+		if (Queue.Contains(Index))
+			Queue.Update(Index, Key, TieBreak);
+		else
+			Queue.Push(Index, Key, TieBreak);
+	}
+	else if (Queue.Contains(Index))
+	{
+		Queue.Remove(Index);
+	}
+}
+
+void DStarLite::ComputeShortestPath()
+{
+	while (!Queue.Empty())
+	{
+		//Stop once nothing left in the queue could change the start tile's distance
+		int Key, TieBreak;
+		CalculateKey(StartTile, Key, TieBreak);
+		if (Queue.TopPriority() >= IndexedHeap::MakePriority(Key, TieBreak) && Rhs[StartTile] == G[StartTile])
+			break;
+
+		int Current = Queue.Top();
+		uint64_t OldPriority = Queue.TopPriority();
+		CalculateKey(Current, Key, TieBreak);
+
+		int Neighbors[4];
+		int Count = Map.GetNeighbors(Current, Neighbors);
+
+		if (OldPriority < IndexedHeap::MakePriority(Key, TieBreak))
+		{
+			//The key was made for an older start tile, so put it back with its real key
+			Queue.Update(Current, Key, TieBreak);
+		}
+		else if (G[Current] > Rhs[Current])
+		{
+			//The tile got closer to the end tile. Settle it and let its neighbors know.
+			G[Current] = Rhs[Current];
+			Queue.Remove(Current);
+			for (int i = 0; i < Count; ++i)
+				UpdateTile(Neighbors[i]);
+		}
+		else
+		{
+			//The tile got further away. Forget its distance and work it out again along with its neighbors.
+			G[Current] = INFINITE_COST;
+			UpdateTile(Current);
+			for (int i = 0; i < Count; ++i)
+				UpdateTile(Neighbors[i]);
+		}
+	}
+}
+
+void DStarLite::TileChanged(int Index)
+{
+	if (!Initialized)
+		return;
+
+	UpdateTile(Index);
+
+	int Neighbors[4];
+	int Count = Map.GetNeighbors(Index, Neighbors);
+	for (int i = 0; i < Count; ++i)
+		UpdateTile(Neighbors[i]);
+}
+
+vector<int> DStarLite::FindPath(int Start, int End)
+{
+	if (!Initialized || End != EndTile || (int)G.size() != Map.Size())
+	{
+		StartTile = Start;
+		Initialize(End);
+	}
+	else if (Start != StartTile)
+	{
+		KeyModifier += GetDistance(StartTile, Start);
+		StartTile = Start;
+	}
+
+	ComputeShortestPath();
+	if (G[Start] == INFINITE_COST)
+		return vector<int>(); //Return empty path if it cannot be found
+
+	//Walk downhill through the g values to the end tile
+	vector<int> Path;
+	Path.push_back(Start);
+	int Current = Start;
+	while (Current != EndTile)
+	{
+		int Neighbors[4];
+		int Count = Map.GetNeighbors(Current, Neighbors);
+		int Next = -1;
+		for (int i = 0; i < Count; ++i)
+		{
+			if (G[Neighbors[i]] != INFINITE_COST && (Next == -1 || G[Neighbors[i]] < G[Next]))
+				Next = Neighbors[i];
+		}
+
+		if (Next == -1 || (int)Path.size() > Map.Size())
+			return vector<int>();
+
+		Path.push_back(Next);
+		Current = Next;
+	}
+	return Path;
+}
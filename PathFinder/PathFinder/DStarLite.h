@@ -0,0 +1,62 @@
+/**********************************************************
+* Description: D* Lite, an incremental planner.
+*
+* D* Lite searches backwards from the end tile and keeps its
+* search between calls. Every tile has a g value (its distance
+* to the end tile as last computed) and an rhs value (the
+* distance its neighbors say it should have). When a tile
+* switches between blocked and not blocked, only that tile and
+* its neighbors are looked at again, and the next plan repairs
+* the tiles whose g and rhs disagree. An edit usually costs
+* about as much as the part of the search it actually changed.
+*
+* Moving the start tile keeps the search. Moving the end tile
+* starts over.
+*
+* Unlike the other engines the planner keeps its own search
+* instead of using a SearchContext, so it can only run one
+* search at a time. Each agent that needs one gets its own.
+**********************************************************/
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include "TileMap.h"
+#include "IndexedHeap.h"
+
+class DStarLite
+{
+public:
+	DStarLite(const TileMap& _Map) : Map(_Map) {}
+
+	//Tell the planner that a tile switched between blocked and not blocked.
+	//The search is repaired the next time FindPath is called.
+	void TileChanged(int Index);
+
+	//Find the shortest path from Start to End, reusing as much of the last search as possible
+	std::vector<int> FindPath(int Start, int End);
+
+	//Throw away the search so the next FindPath starts from scratch
+	void Reset() { Initialized = false; }
+
+private:
+	int GetDistance(int a, int b) const
+	{
+		return abs(Map.GetX(a) - Map.GetX(b)) + abs(Map.GetY(a) - Map.GetY(b));
+	}
+
+	//The priority of a tile in the queue: its smallest known distance plus the heuristic, then its smallest known distance
+	void CalculateKey(int Index, int& Key, int& TieBreak) const;
+	void Initialize(int End);
+	void UpdateTile(int Index);
+	void ComputeShortestPath();
+
+	const TileMap& Map;
+	bool Initialized = false;
+	int StartTile = -1; //Where the start tile was when the last plan was made
+	int EndTile = -1;
+	int KeyModifier = 0; //Added to every new key so the keys already in the queue stay valid after the start tile moves
+	std::vector<int> G;
+	std::vector<int> Rhs;
+	IndexedHeap Queue; //Tiles whose g and rhs disagree
+};
@@ -0,0 +1,168 @@
+#include "FlowField.h"
+#include <cstdlib>
+using std::vector;
+
+void FlowField::Build(int _Goal)
+{
+	Goal = _Goal;
+	Distances.assign(Map.Size(), UINT32_MAX);
+	Directions.assign(Map.Size(), NO_DIRECTION);
+	Affected.assign(Map.Size(), 0);
+	if (Map.State[Goal] == BLOCKED)
+		return;
+
+	Distances[Goal] = 0;
+	Queue.clear();
+	Queue.push_back(Goal);
+	Spread();
+}
+
+int FlowField::GetNeighbor(int Index, int Dir) const
+{
+	int x = Map.GetX(Index);
+	int y = Map.GetY(Index);
+	int Neighbor;
+	switch (Dir)
+	{
+	case UP: Neighbor = y > 0 ? Index - Map.Width : -1; break;
+	case DOWN: Neighbor = y < Map.Height - 1 ? Index + Map.Width : -1; break;
+	case LEFT: Neighbor = x > 0 ? Index - 1 : -1; break;
+	default: Neighbor = x < Map.Width - 1 ? Index + 1 : -1; break;
+	}
+	return Neighbor != -1 && Map.State[Neighbor] != BLOCKED ? Neighbor : -1;
+}
+
+bool FlowField::TakeBestNeighbor(int Index, bool SkipAffected)
+{
+	for (int d = UP; d <= RIGHT; ++d)
+	{
+		int n = GetNeighbor(Index, d);
+		if (n == -1 || Distances[n] == UINT32_MAX || (SkipAffected && Affected[n]))
+			continue;
+
+		if (Distances[n] + 1 < Distances[Index])
+		{
+			Distances[Index] = Distances[n] + 1;
+			Directions[Index] = (uint8_t)d;
+		}
+	}
+	return Distances[Index] != UINT32_MAX;
+}
+
+void FlowField::Spread()
+{
+	//Every step costs 1, so going through the tiles in the order they were reached is the same as Dijkstra's order
+	for (size_t Head = 0; Head < Queue.size(); ++Head)
+	{
+		int t = Queue[Head];
+		for (int d = UP; d <= RIGHT; ++d)
+		{
+			int n = GetNeighbor(t, d);
+			if (n == -1 || Distances[t] + 1 >= Distances[n])
+				continue;
+
+			Distances[n] = Distances[t] + 1;
+			Directions[n] = (uint8_t)(d ^ 1); //The way back from n to t
+			Queue.push_back(n);
+		}
+	}
+}
+
+void FlowField::TileChanged(int Index)
+{
+	if (!IsBuilt())
+		return;
+
+	//Blocking or clearing the goal itself changes every distance
+	if (Index == Goal)
+		Build(Goal);
+	else if (Map.State[Index] == BLOCKED)
+		Raise(Index);
+	else
+		Lower(Index);
+}
+
+void FlowField::Lower(int Index)
+{
+	if (!TakeBestNeighbor(Index, false))
+		return;
+
+	Queue.clear();
+	Queue.push_back(Index);
+	Spread();
+}
+
+void FlowField::Raise(int Index)
+{
+	//Find every tile whose directions lead through the blocked tile
+	Queue.clear();
+	Queue.push_back(Index);
+	Affected[Index] = 1;
+	for (size_t Head = 0; Head < Queue.size(); ++Head)
+	{
+		int t = Queue[Head];
+		for (int d = UP; d <= RIGHT; ++d)
+		{
+			int n = GetNeighbor(t, d);
+			if (n != -1 && !Affected[n] && Directions[n] == (d ^ 1))
+			{
+				Affected[n] = 1;
+				Queue.push_back(n);
+			}
+		}
+	}
+
+	for (int t : Queue)
+	{
+		Distances[t] = UINT32_MAX;
+		Directions[t] = NO_DIRECTION;
+	}
+
+	//Start each affected tile off with what the tiles around it still offer, then let the best distances spread
+	Repairs.Clear();
+	for (int t : Queue)
+	{
+		if (t != Index && TakeBestNeighbor(t, true))
+			Repairs.Push(t, Distances[t]);
+	}
+
+	while (!Repairs.Empty())
+	{
+		int t = Repairs.Pop();
+		for (int d = UP; d <= RIGHT; ++d)
+		{
+			int n = GetNeighbor(t, d);
+			if (n == -1 || !Affected[n] || Distances[t] + 1 >= Distances[n])
+				continue;
+
+			Distances[n] = Distances[t] + 1;
+			Directions[n] = (uint8_t)(d ^ 1);
+			Repairs.Push(n, Distances[n]);
+		}
+	}
+
+	for (int t : Queue)
+		Affected[t] = 0;
+}
+
+vector<int> FlowField::FindPath(int Start, int End)
+{
+	if (Goal != End)
+		Build(End);
+
+	return FindPath(Start);
+}
+
+vector<int> FlowField::FindPath(int Start) const
+{
+	vector<int> Path;
+	if (Distances[Start] == UINT32_MAX)
+		return Path; //Return empty path if it cannot be found
+
+	int Steps[4] = { -Map.Width, Map.Width, -1, 1 };
+	Path.reserve(Distances[Start] + 1);
+	Path.push_back(Start);
+	for (int t = Start; t != Goal; Path.push_back(t))
+		t += Steps[Directions[t]];
+	return Path;
+}
@@ -0,0 +1,85 @@
+/**********************************************************
+* Description: A flow field, the distance from every tile to
+* one goal tile and the direction to step in to get closer.
+*
+* The field is found once with a breadth first search outward
+* from the goal (every step costs 1, so this is Dijkstra's
+* algorithm). After that, the path from any start tile is read
+* off by following the directions, which costs as much as the
+* path is long. This pays off when many units head to the same
+* tile.
+*
+* The field is repaired when a tile changes instead of being
+* found again. Clearing a tile can only make tiles closer, so
+* the shorter distances spread out from it. Blocking a tile
+* only affects the tiles whose directions led through it. Those
+* tiles forget their distances, take the best distance their
+* other neighbors offer, and spread it among themselves.
+*
+* Reading paths doesn't change the field, so any number of
+* threads can read from it at once while the map and goal stay
+* the same.
+**********************************************************/
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "TileMap.h"
+#include "BucketQueue.h"
+
+class FlowField
+{
+public:
+	FlowField(const TileMap& _Map) : Map(_Map) {}
+
+	//Find the distances and directions from every tile to Goal
+	void Build(int _Goal);
+
+	//Repair the field after a tile switched between blocked and not blocked
+	void TileChanged(int Index);
+
+	//Follow the field from Start to End, building it for End first if it was built for another goal
+	std::vector<int> FindPath(int Start, int End);
+
+	//Follow the field from Start to the goal it was built for. Returns an empty path if the goal can't be reached.
+	std::vector<int> FindPath(int Start) const;
+
+	//Steps from a tile to the goal, or -1 if the goal can't be reached from it
+	int GetDistance(int Index) const { return Distances[Index] == UINT32_MAX ? -1 : (int)Distances[Index]; }
+
+	int GetGoal() const { return Goal; }
+	bool IsBuilt() const { return Goal != -1; }
+
+private:
+	//The directions in the order of their codes. Flipping the lowest bit gives the opposite direction.
+	enum Direction : uint8_t
+	{
+		UP = 0,
+		DOWN,
+		LEFT,
+		RIGHT,
+		NO_DIRECTION //The goal, and every tile that can't reach it
+	};
+
+	//The tile one step from Index in the direction, or -1 if it is off the map or blocked
+	int GetNeighbor(int Index, int Dir) const;
+
+	//Give Index the best distance its neighbors offer, leaving out the affected ones if SkipAffected is set.
+	//Returns false if no neighbor can reach the goal.
+	bool TakeBestNeighbor(int Index, bool SkipAffected);
+
+	//Pass shorter distances on from the tiles in Queue until nothing gets shorter
+	void Spread();
+
+	void Lower(int Index);
+	void Raise(int Index);
+
+	const TileMap& Map;
+	int Goal = -1;
+	std::vector<uint32_t> Distances; //Steps to the goal, or UINT32_MAX if it can't be reached
+	std::vector<uint8_t> Directions; //Which way to step from each tile to get closer to the goal
+
+	//Scratch space for repairs
+	std::vector<int> Queue;
+	std::vector<uint8_t> Affected; //Tiles whose directions led through a tile that was just blocked
+	BucketQueue Repairs;
+};
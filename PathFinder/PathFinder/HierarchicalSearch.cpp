@@ -0,0 +1,354 @@
+#include "HierarchicalSearch.h"
+#include <algorithm>
+#include <cstdlib>
+using std::vector;
+using std::pair;
+
+void HierarchicalSearch::Build()
+{
+	ClustersWide = (Map.Width + ClusterSize - 1) / ClusterSize;
+	ClustersHigh = (Map.Height + ClusterSize - 1) / ClusterSize;
+	int ClusterCount = ClustersWide * ClustersHigh;
+
+	Clusters.assign(ClusterCount, Cluster());
+	RightBorders.assign(ClusterCount, vector<pair<int, int>>());
+	DownBorders.assign(ClusterCount, vector<pair<int, int>>());
+	EntranceSlot.assign(Map.Size(), -1);
+	ClusterDistances.assign(ClusterSize * ClusterSize, -1);
+	ClusterParents.assign(ClusterSize * ClusterSize, -1);
+	ClusterQueue.reserve(ClusterSize * ClusterSize);
+
+	//Every cluster reads the borders of its neighbors, so find all the borders first
+	for (int c = 0; c < ClusterCount; ++c)
+	{
+		BuildRightBorder(c);
+		BuildDownBorder(c);
+	}
+	for (int c = 0; c < ClusterCount; ++c)
+		BuildCluster(c);
+
+	Built = true;
+}
+
+void HierarchicalSearch::AddEntrances(vector<pair<int, int>>& Border, int From, int Step, int Across, int Length)
+{
+	Border.clear();
+
+	//Look for runs of tiles that are empty on both sides of the border
+	int RunStart = -1;
+	for (int i = 0; i <= Length; ++i)
+	{
+		int Index = From + i * Step;
+		bool Open = i < Length && Map.State[Index] != BLOCKED && Map.State[Index + Across] != BLOCKED;
+
+		if (Open && RunStart == -1)
+		{
+			RunStart = i;
+		}
+		else if (!Open && RunStart != -1)
+		{
+			//Short runs get one entrance in the middle, long runs get one at each end
+			int RunLength = i - RunStart;
+			if (RunLength < 6)
+			{
+				int Middle = From + (RunStart + RunLength / 2) * Step;
+				Border.push_back({ Middle, Middle + Across });
+			}
+			else
+			{
+				int First = From + RunStart * Step;
+				int Last = From + (i - 1) * Step;
+				Border.push_back({ First, First + Across });
+				Border.push_back({ Last, Last + Across });
+			}
+			RunStart = -1;
+		}
+	}
+}
+
+void HierarchicalSearch::BuildRightBorder(int Cluster)
+{
+	int cx = Cluster % ClustersWide;
+	int cy = Cluster / ClustersWide;
+	if (cx == ClustersWide - 1)
+	{
+		RightBorders[Cluster].clear();
+		return;
+	}
+
+	int Top = cy * ClusterSize;
+	int Length = std::min(ClusterSize, Map.Height - Top);
+	AddEntrances(RightBorders[Cluster], Map.GetIndex((cx + 1) * ClusterSize - 1, Top), Map.Width, 1, Length);
+}
+
+void HierarchicalSearch::BuildDownBorder(int Cluster)
+{
+	int cx = Cluster % ClustersWide;
+	int cy = Cluster / ClustersWide;
+	if (cy == ClustersHigh - 1)
+	{
+		DownBorders[Cluster].clear();
+		return;
+	}
+
+	int Left = cx * ClusterSize;
+	int Length = std::min(ClusterSize, Map.Width - Left);
+	AddEntrances(DownBorders[Cluster], Map.GetIndex(Left, (cy + 1) * ClusterSize - 1), 1, Map.Width, Length);
+}
+
+void HierarchicalSearch::BuildCluster(int ClusterIndex)
+{
+	Cluster& C = Clusters[ClusterIndex];
+	for (int Entrance : C.Entrances)
+		EntranceSlot[Entrance] = -1;
+	C.Entrances.clear();
+	C.Edges.clear();
+
+	auto AddLink = [&](int Entrance, int Across)
+	{
+		int Slot = EntranceSlot[Entrance];
+		if (Slot == -1)
+		{
+			Slot = (int)C.Entrances.size();
+			EntranceSlot[Entrance] = Slot;
+			C.Entrances.push_back(Entrance);
+			C.Edges.emplace_back();
+		}
+		C.Edges[Slot].push_back({ Across, 1 });
+	};
+
+	//Gather the entrances from all four borders. The left and top borders belong to the neighbors.
+	for (auto& p : RightBorders[ClusterIndex])
+		AddLink(p.first, p.second);
+	for (auto& p : DownBorders[ClusterIndex])
+		AddLink(p.first, p.second);
+	if (ClusterIndex % ClustersWide > 0)
+	{
+		for (auto& p : RightBorders[ClusterIndex - 1])
+			AddLink(p.second, p.first);
+	}
+	if (ClusterIndex / ClustersWide > 0)
+	{
+		for (auto& p : DownBorders[ClusterIndex - ClustersWide])
+			AddLink(p.second, p.first);
+	}
+
+	//Join every pair of entrances that can reach each other without leaving the cluster
+	for (int i = 0; i < (int)C.Entrances.size(); ++i)
+	{
+		SearchCluster(ClusterIndex, C.Entrances[i], ClusterDistances, ClusterParents, ClusterQueue);
+		for (int j = 0; j < (int)C.Entrances.size(); ++j)
+		{
+			int Distance = ClusterDistances[GetLocal(ClusterIndex, C.Entrances[j])];
+			if (i != j && Distance > 0)
+				C.Edges[i].push_back({ C.Entrances[j], Distance });
+		}
+	}
+}
+
+void HierarchicalSearch::SearchCluster(int ClusterIndex, int From, vector<int>& Distances, vector<int>& Parents, vector<int>& Queue) const
+{
+	int Left = (ClusterIndex % ClustersWide) * ClusterSize;
+	int Top = (ClusterIndex / ClustersWide) * ClusterSize;
+	int Right = std::min(Left + ClusterSize, Map.Width);
+	int Bottom = std::min(Top + ClusterSize, Map.Height);
+
+	Distances.assign(ClusterSize * ClusterSize, -1);
+	Parents.resize(ClusterSize * ClusterSize);
+	Queue.clear();
+
+	int FromLocal = GetLocal(ClusterIndex, From);
+	Distances[FromLocal] = 0;
+	Parents[FromLocal] = -1;
+	Queue.push_back(FromLocal);
+
+	for (size_t Head = 0; Head < Queue.size(); ++Head)
+	{
+		int Local = Queue[Head];
+		int x = Left + Local % ClusterSize;
+		int y = Top + Local / ClusterSize;
+
+		int Directions[4][2] = { { 0, -1 }, { 0, 1 }, { -1, 0 }, { 1, 0 } };
+		for (auto& d : Directions)
+		{
+			int nx = x + d[0];
+			int ny = y + d[1];
+			if (nx < Left || ny < Top || nx >= Right || ny >= Bottom || Map.State[Map.GetIndex(nx, ny)] == BLOCKED)
+				continue;
+
+			int NextLocal = (ny - Top) * ClusterSize + (nx - Left);
+			if (Distances[NextLocal] != -1)
+				continue;
+
+			Distances[NextLocal] = Distances[Local] + 1;
+			Parents[NextLocal] = Local;
+			Queue.push_back(NextLocal);
+		}
+	}
+}
+
+void HierarchicalSearch::TileChanged(int Index)
+{
+	if (!Built)
+		return;
+
+	int ClusterIndex = GetCluster(Index);
+	int cx = ClusterIndex % ClustersWide;
+	int cy = ClusterIndex / ClustersWide;
+	int LocalX = Map.GetX(Index) - cx * ClusterSize;
+	int LocalY = Map.GetY(Index) - cy * ClusterSize;
+
+	//A tile on a border can change the entrances, and then the cluster across the border changes too
+	int Changed[5] = { ClusterIndex };
+	int ChangedCount = 1;
+	if (LocalX == ClusterSize - 1 && cx < ClustersWide - 1)
+	{
+		BuildRightBorder(ClusterIndex);
+		Changed[ChangedCount++] = ClusterIndex + 1;
+	}
+	if (LocalX == 0 && cx > 0)
+	{
+		BuildRightBorder(ClusterIndex - 1);
+		Changed[ChangedCount++] = ClusterIndex - 1;
+	}
+	if (LocalY == ClusterSize - 1 && cy < ClustersHigh - 1)
+	{
+		BuildDownBorder(ClusterIndex);
+		Changed[ChangedCount++] = ClusterIndex + ClustersWide;
+	}
+	if (LocalY == 0 && cy > 0)
+	{
+		BuildDownBorder(ClusterIndex - ClustersWide);
+		Changed[ChangedCount++] = ClusterIndex - ClustersWide;
+	}
+
+	for (int i = 0; i < ChangedCount; ++i)
+		BuildCluster(Changed[i]);
+}
+
+vector<int> HierarchicalSearch::FindPath(SearchContext& Context, int Start, int End)
+{
+	if (!Built)
+		Build();
+
+	IndexedHeap& OpenList = Context.OpenList;
+	vector<int>& StartDistances = Context.StartDistances;
+	vector<int>& EndDistances = Context.EndDistances;
+	vector<int>& Parents = Context.ClusterParents;
+	vector<int>& Queue = Context.ClusterQueue;
+
+	//Connect the start and end tiles to the entrances of their own clusters
+	int StartCluster = GetCluster(Start);
+	int EndCluster = GetCluster(End);
+	SearchCluster(StartCluster, Start, StartDistances, Parents, Queue);
+	SearchCluster(EndCluster, End, EndDistances, Parents, Queue);
+
+	int EndX = Map.GetX(End);
+	int EndY = Map.GetY(End);
+	auto GetDistance = [&](int t)
+	{
+		return abs(Map.GetX(t) - EndX) + abs(Map.GetY(t) - EndY);
+	};
+
+	auto Relax = [&](int From, int To, int Cost)
+	{
+		Context.Touch(To);
+		uint32_t NewG = Context.G[From] + Cost;
+		if (Context.List[To] == CLOSED || NewG >= Context.G[To])
+			return;
+
+		int NewH = GetDistance(To);
+		Context.G[To] = NewG;
+		Context.Parent[To] = From;
+		if (Context.List[To] == OPENED)
+		{
+			OpenList.DecreaseKey(To, NewG + NewH, NewH);
+		}
+		else
+		{
+			OpenList.Push(To, NewG + NewH, NewH);
+			Context.Stats.CountPush(OpenList.Size());
+			Context.List[To] = OPENED;
+		}
+	};
+
+	//Search the abstract graph
+	Context.BeginSearch(Map.Size());
+	OpenList.Clear();
+	Context.Touch(Start);
+	Context.G[Start] = 0;
+	OpenList.Push(Start, GetDistance(Start), GetDistance(Start));
+	Context.Stats.CountPush(OpenList.Size());
+	Context.List[Start] = OPENED;
+
+	bool Found = false;
+	while (!OpenList.Empty())
+	{
+		int Current = OpenList.Pop();
+		Context.List[Current] = CLOSED;
+		++Context.Stats.Expanded;
+
+		if (Current == End)
+		{
+			Found = true;
+			break;
+		}
+
+		if (Current == Start)
+		{
+			for (int Entrance : Clusters[StartCluster].Entrances)
+			{
+				int Distance = StartDistances[GetLocal(StartCluster, Entrance)];
+				if (Distance > 0)
+					Relax(Current, Entrance, Distance);
+			}
+		}
+
+		int Slot = EntranceSlot[Current];
+		if (Slot != -1)
+		{
+			for (const Edge& e : Clusters[GetCluster(Current)].Edges[Slot])
+				Relax(Current, e.To, e.Cost);
+		}
+
+		if (GetCluster(Current) == EndCluster)
+		{
+			int Distance = EndDistances[GetLocal(EndCluster, Current)];
+			if (Distance >= 0)
+				Relax(Current, End, Distance);
+		}
+	}
+
+	if (!Found)
+		return vector<int>(); //Return empty path if it cannot be found
+
+	vector<int> Abstract;
+	for (uint32_t t = End; t != NO_PARENT; t = Context.Parent[t])
+		Abstract.push_back(t);
+	std::reverse(Abstract.begin(), Abstract.end());
+
+	//Turn each abstract step into tiles. Steps across a border are already next to each other.
+	vector<int> Path;
+	Path.push_back(Start);
+	for (size_t i = 1; i < Abstract.size(); ++i)
+	{
+		int From = Abstract[i - 1];
+		int To = Abstract[i];
+		int ClusterIndex = GetCluster(From);
+		if (ClusterIndex != GetCluster(To))
+		{
+			Path.push_back(To);
+			continue;
+		}
+
+		//The start tile's distances aren't needed anymore, so their space is reused
+		SearchCluster(ClusterIndex, From, StartDistances, Parents, Queue);
+		int Left = (ClusterIndex % ClustersWide) * ClusterSize;
+		int Top = (ClusterIndex / ClustersWide) * ClusterSize;
+		size_t Mark = Path.size();
+		for (int Local = GetLocal(ClusterIndex, To); Local != GetLocal(ClusterIndex, From); Local = Parents[Local])
+			Path.push_back(Map.GetIndex(Left + Local % ClusterSize, Top + Local / ClusterSize));
+		std::reverse(Path.begin() + Mark, Path.end());
+	}
+	return Path;
+}
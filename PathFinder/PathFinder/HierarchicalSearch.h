@@ -0,0 +1,96 @@
+/**********************************************************
+* Description: Hierarchical path finding (HPA*).
+*
+* The map is split into square clusters. Wherever a run of
+* empty tiles crosses the border between two clusters, one or
+* two tiles of the run become entrances. Entrances of the same
+* cluster are joined by the length of the shortest path between
+* them inside the cluster, and entrances facing each other
+* across a border are joined with a cost of 1.
+*
+* A query connects the start and end tiles to the entrances of
+* their own clusters, searches this small abstract graph, and
+* then fills in each abstract step with a search that never
+* leaves one cluster. Paths are close to the shortest, but not
+* always the shortest.
+*
+* When a tile changes, only its own cluster's edges are
+* recomputed, plus the cluster across the border if the tile
+* lies on one.
+**********************************************************/
+#pragma once
+#include <vector>
+#include <utility>
+#include "TileMap.h"
+#include "SearchContext.h"
+
+class HierarchicalSearch
+{
+public:
+	HierarchicalSearch(const TileMap& _Map, int _ClusterSize = 8) : Map(_Map), ClusterSize(_ClusterSize) {}
+
+	//Split the map into clusters and build the whole abstract graph
+	void Build();
+
+	//Update the abstract graph after a tile switched between blocked and not blocked
+	void TileChanged(int Index);
+
+	//Find a path from Start to End using the search planes of the context.
+	//Builds the abstract graph first if it hasn't been built yet, so searches
+	//from several threads at once need it to have been built already.
+	std::vector<int> FindPath(SearchContext& Context, int Start, int End);
+
+	bool IsBuilt() const { return Built; }
+	int GetClusterSize() const { return ClusterSize; }
+
+private:
+	struct Edge
+	{
+		int To; //Tile index of the entrance at the other end
+		int Cost;
+	};
+
+	struct Cluster
+	{
+		std::vector<int> Entrances; //Tile index of every entrance on the border of this cluster
+		std::vector<std::vector<Edge>> Edges; //Edges[i] leave Entrances[i], either inside the cluster or across a border
+	};
+
+	int GetCluster(int Index) const
+	{
+		return (Map.GetY(Index) / ClusterSize) * ClustersWide + Map.GetX(Index) / ClusterSize;
+	}
+
+	int GetLocal(int Cluster, int Index) const
+	{
+		return (Map.GetY(Index) - (Cluster / ClustersWide) * ClusterSize) * ClusterSize + Map.GetX(Index) - (Cluster % ClustersWide) * ClusterSize;
+	}
+
+	//Find the entrances along the right and bottom borders of a cluster
+	void BuildRightBorder(int Cluster);
+	void BuildDownBorder(int Cluster);
+	void AddEntrances(std::vector<std::pair<int, int>>& Border, int From, int Step, int Across, int Length);
+
+	//Collect a cluster's entrances from its four borders and find the paths between them
+	void BuildCluster(int Cluster);
+
+	//Breadth first search from a tile that never leaves its cluster. Fills Distances and Parents
+	//with one entry per tile of the cluster, -1 where it can't be reached. Queue is scratch space.
+	void SearchCluster(int Cluster, int From, std::vector<int>& Distances, std::vector<int>& Parents, std::vector<int>& Queue) const;
+
+	const TileMap& Map;
+	int ClusterSize;
+	int ClustersWide = 0;
+	int ClustersHigh = 0;
+	bool Built = false;
+
+	std::vector<Cluster> Clusters;
+	std::vector<std::vector<std::pair<int, int>>> RightBorders; //Entrance pairs between each cluster and the one to its right
+	std::vector<std::vector<std::pair<int, int>>> DownBorders; //Entrance pairs between each cluster and the one below it
+	std::vector<int> EntranceSlot; //Position of each tile in its cluster's Entrances, or -1 if it isn't an entrance
+
+	//Scratch space for the searches inside a cluster while building. Queries use their context instead.
+	std::vector<int> ClusterDistances;
+	std::vector<int> ClusterParents;
+	std::vector<int> ClusterQueue;
+};
@@ -0,0 +1,109 @@
+#include "IndexedHeap.h"
+
+void IndexedHeap::Resize(int TileCount)
+{
+	Entries.clear();
+	Positions.assign(TileCount, -1);
+}
+
+void IndexedHeap::Push(int Index, int Key, int TieBreak)
+{
+	Positions[Index] = (int)Entries.size();
+	Entries.push_back({ MakePriority(Key, TieBreak), Index });
+	SiftUp((int)Entries.size() - 1);
+}
+
+void IndexedHeap::DecreaseKey(int Index, int Key, int TieBreak)
+{
+	int Pos = Positions[Index];
+	Entries[Pos].Priority = MakePriority(Key, TieBreak);
+	SiftUp(Pos);
+}
+
+void IndexedHeap::Update(int Index, int Key, int TieBreak)
+{
+	int Pos = Positions[Index];
+	uint64_t OldPriority = Entries[Pos].Priority;
+	Entries[Pos].Priority = MakePriority(Key, TieBreak);
+
+	if (Entries[Pos].Priority < OldPriority)
+		SiftUp(Pos);
+	else
+		SiftDown(Pos);
+}
+
+int IndexedHeap::Pop()
+{
+	int Top = Entries[0].Index;
+	Remove(Top);
+	return Top;
+}
+
+void IndexedHeap::Remove(int Index)
+{
+	int Pos = Positions[Index];
+	Positions[Index] = -1;
+
+	//Move the last entry into the hole and let it move back into place
+	Entry Last = Entries.back();
+	Entries.pop_back();
+	if (Pos < (int)Entries.size())
+	{
+		uint64_t OldPriority = Entries[Pos].Priority;
+		Entries[Pos] = Last;
+		Positions[Last.Index] = Pos;
+		if (Last.Priority < OldPriority)
+			SiftUp(Pos);
+		else
+			SiftDown(Pos);
+	}
+}
+
+void IndexedHeap::Clear()
+{
+	for (const Entry& e : Entries)
+		Positions[e.Index] = -1;
+	Entries.clear();
+}
+
+void IndexedHeap::SiftUp(int Pos)
+{
+	Entry Moving = Entries[Pos];
+	while (Pos > 0)
+	{
+		int ParentPos = (Pos - 1) / 2;
+		if (Entries[ParentPos].Priority <= Moving.Priority)
+			break;
+
+		Entries[Pos] = Entries[ParentPos];
+		Positions[Entries[Pos].Index] = Pos;
+		Pos = ParentPos;
+	}
+	Entries[Pos] = Moving;
+	Positions[Moving.Index] = Pos;
+}
+
+void IndexedHeap::SiftDown(int Pos)
+{
+	int Count = (int)Entries.size();
+	Entry Moving = Entries[Pos];
+	while (true)
+	{
+		int ChildPos = Pos * 2 + 1;
+		if (ChildPos >= Count)
+			break;
+
+		//Pick the smaller of the two children
+		if (ChildPos + 1 < Count && Entries[ChildPos + 1].Priority < Entries[ChildPos].Priority)
+			++ChildPos;
+
+		if (Moving.Priority <= Entries[ChildPos].Priority)
+			break;
+
+		Entries[Pos] = Entries[ChildPos];
+		Positions[Entries[Pos].Index] = Pos;
+		Pos = ChildPos;
+	}
+	Entries[Pos] = Moving;
+	Positions[Moving.Index] = Pos;
+}
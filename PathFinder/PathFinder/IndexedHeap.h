@@ -0,0 +1,69 @@
+/**********************************************************
+* Description: A binary min-heap of tile indices. Every tile
+* that is in the heap knows its position in it, so a tile can
+* be found and have its priority lowered in O(log n) instead of
+* being pushed a second time.
+*
+* Entries are ordered by their key first and their tie break
+* second, so A* can prefer the tile closest to the goal when
+* two tiles share the same f value.
+**********************************************************/
+#pragma once
+#include <vector>
+#include <cstdint>
+
+class IndexedHeap
+{
+public:
+	//Must be called with the number of tiles in the map before the heap is used
+	void Resize(int TileCount);
+
+	bool Empty() const { return Entries.empty(); }
+	int Size() const { return (int)Entries.size(); }
+	bool Contains(int Index) const { return Positions[Index] != -1; }
+
+	//A heap moves a tile instead of leaving an old entry behind, so there is never a stale entry to skip.
+	//Only here so a search can use either open list.
+	void SkipStale() {}
+
+	//Add a tile that is not already in the heap
+	void Push(int Index, int Key, int TieBreak = 0);
+
+	//Lower the priority of a tile that is already in the heap
+	void DecreaseKey(int Index, int Key, int TieBreak = 0);
+
+	//Raise or lower the priority of a tile that is already in the heap
+	void Update(int Index, int Key, int TieBreak = 0);
+
+	//The tile with the smallest priority and that priority, without removing it
+	int Top() const { return Entries[0].Index; }
+	uint64_t TopPriority() const { return Entries[0].Priority; }
+
+	//Remove and return the tile with the smallest priority
+	int Pop();
+
+	//Remove a tile from anywhere in the heap
+	void Remove(int Index);
+
+	//Remove every tile from the heap. Only touches the tiles that are still in it.
+	void Clear();
+
+	//The combined priority that entries are ordered by, for comparing against TopPriority
+	static uint64_t MakePriority(int Key, int TieBreak)
+	{
+		return ((uint64_t)(uint32_t)Key << 32) | (uint32_t)TieBreak;
+	}
+
+private:
+	struct Entry
+	{
+		uint64_t Priority;
+		int Index;
+	};
+
+	void SiftUp(int Pos);
+	void SiftDown(int Pos);
+
+	std::vector<Entry> Entries;
+	std::vector<int> Positions; //Position of each tile in Entries, or -1 if the tile is not in the heap
+};
@@ -0,0 +1,160 @@
+#include "JumpPointSearch.h"
+#include <algorithm>
+#include <cstdlib>
+using std::vector;
+
+int JumpPointSearch::JumpVertical(int x, int y, int dy, int End) const
+{
+	while (true)
+	{
+		y += dy;
+		if (!IsFree(x, y))
+			return -1;
+
+		int Index = Map.GetIndex(x, y);
+		if (Index == End)
+			return Index;
+
+		//A turn to the side is forced if the side tile is open but the one next to the tile we came from is not
+		if ((IsFree(x - 1, y) && !IsFree(x - 1, y - dy)) || (IsFree(x + 1, y) && !IsFree(x + 1, y - dy)))
+			return Index;
+	}
+}
+
+int JumpPointSearch::Jump(int x, int y, int dx, int dy, int End) const
+{
+	if (dy != 0)
+		return JumpVertical(x, y, dy, End);
+
+	while (true)
+	{
+		x += dx;
+		if (!IsFree(x, y))
+			return -1;
+
+		int Index = Map.GetIndex(x, y);
+		if (Index == End)
+			return Index;
+
+		//A horizontal run may turn vertical at any tile, so stop wherever a vertical jump would find something
+		if (JumpVertical(x, y, 1, End) != -1 || JumpVertical(x, y, -1, End) != -1)
+			return Index;
+	}
+}
+
+void JumpPointSearch::AddJumpPoint(SearchContext& Context, int From, int JumpPoint, int End) const
+{
+	Context.Touch(JumpPoint);
+	if (Context.List[JumpPoint] == CLOSED)
+		return;
+
+	int EndX = Map.GetX(End);
+	int EndY = Map.GetY(End);
+	int x = Map.GetX(JumpPoint);
+	int y = Map.GetY(JumpPoint);
+
+	//Jump points are always in a straight line from each other
+	uint32_t NewG = Context.G[From] + abs(x - Map.GetX(From)) + abs(y - Map.GetY(From));
+	if (NewG >= Context.G[JumpPoint])
+		return;
+
+	int NewH = abs(x - EndX) + abs(y - EndY);
+	int NewF = NewG + NewH;
+	Context.G[JumpPoint] = NewG;
+	Context.Parent[JumpPoint] = From;
+
+	if (Context.List[JumpPoint] == OPENED)
+	{
+		Context.OpenList.DecreaseKey(JumpPoint, NewF, NewH);
+	}
+	else
+	{
+		Context.OpenList.Push(JumpPoint, NewF, NewH);
+		Context.Stats.CountPush(Context.OpenList.Size());
+		Context.List[JumpPoint] = OPENED;
+	}
+}
+
+vector<int> JumpPointSearch::FindPath(SearchContext& Context, int Start, int End) const
+{
+	IndexedHeap& OpenList = Context.OpenList;
+	Context.BeginSearch(Map.Size());
+	OpenList.Clear();
+	Context.Touch(Start);
+	Context.G[Start] = 0;
+	int StartH = abs(Map.GetX(Start) - Map.GetX(End)) + abs(Map.GetY(Start) - Map.GetY(End));
+	OpenList.Push(Start, StartH, StartH);
+	Context.Stats.CountPush(OpenList.Size());
+	Context.List[Start] = OPENED;
+
+	while (!OpenList.Empty())
+	{
+		int Current = OpenList.Pop();
+		Context.List[Current] = CLOSED;
+		++Context.Stats.Expanded;
+
+		if (Current == End)
+		{
+			//Walk back through the jump points and fill in the straight runs between them
+			vector<int> Path;
+			Path.push_back(Current);
+			for (int t = Current; Context.Parent[t] != NO_PARENT; t = Context.Parent[t])
+			{
+				int p = Context.Parent[t];
+				int Step = abs(p - t) < Map.Width ? (p > t ? 1 : -1) : (p > t ? Map.Width : -Map.Width);
+				for (int i = t + Step; i != p; i += Step)
+					Path.push_back(i);
+				Path.push_back(p);
+			}
+			std::reverse(Path.begin(), Path.end());
+			return Path;
+		}
+
+		int x = Map.GetX(Current);
+		int y = Map.GetY(Current);
+
+		if (Context.Parent[Current] == NO_PARENT)
+		{
+			//The start tile has no direction yet, so jump every way
+			int Directions[4][2] = { { 0, -1 }, { 0, 1 }, { -1, 0 }, { 1, 0 } };
+			for (auto& d : Directions)
+			{
+				int JumpPoint = Jump(x, y, d[0], d[1], End);
+				if (JumpPoint != -1) AddJumpPoint(Context, Current, JumpPoint, End);
+			}
+			continue;
+		}
+
+		int px = Map.GetX(Context.Parent[Current]);
+		int py = Map.GetY(Context.Parent[Current]);
+		int dx = (x > px) - (x < px);
+		int dy = (y > py) - (y < py);
+
+		if (dx != 0)
+		{
+			//Arrived moving horizontally: keep going, or turn up or down
+			int Horizontal = Jump(x, y, dx, 0, End);
+			int Up = Jump(x, y, 0, -1, End);
+			int Down = Jump(x, y, 0, 1, End);
+			if (Horizontal != -1) AddJumpPoint(Context, Current, Horizontal, End);
+			if (Up != -1) AddJumpPoint(Context, Current, Up, End);
+			if (Down != -1) AddJumpPoint(Context, Current, Down, End);
+		}
+		else
+		{
+			//Arrived moving vertically: keep going, and only turn to a side when the turn is forced
+			int Vertical = Jump(x, y, 0, dy, End);
+			if (Vertical != -1) AddJumpPoint(Context, Current, Vertical, End);
+
+			for (int Side = -1; Side <= 1; Side += 2)
+			{
+				if (IsFree(x + Side, y) && !IsFree(x + Side, y - dy))
+				{
+					int Turn = Jump(x, y, Side, 0, End);
+					if (Turn != -1) AddJumpPoint(Context, Current, Turn, End);
+				}
+			}
+		}
+	}
+	return vector<int>(); //Return empty path if it cannot be found
+}
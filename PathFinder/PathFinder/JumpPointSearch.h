@@ -0,0 +1,45 @@
+/**********************************************************
+* Description: Jump Point Search for the 4-connected grid.
+*
+* On a grid where every step costs the same, many shortest
+* paths are just different orderings of the same moves. JPS
+* only follows one of them: a path may turn from a horizontal
+* move to a vertical one at any tile, but it may only turn from
+* a vertical move to a horizontal one when the tile it would
+* have passed through first is blocked (a "forced" turn).
+*
+* Straight runs are then skipped over in a single jump, and
+* only the tiles where a path may have to turn (jump points)
+* are put in the open list.
+**********************************************************/
+#pragma once
+#include <vector>
+#include "TileMap.h"
+#include "SearchContext.h"
+
+class JumpPointSearch
+{
+public:
+	JumpPointSearch(const TileMap& _Map) : Map(_Map) {}
+	virtual ~JumpPointSearch() = default;
+
+	//Find the shortest path from Start to End using the search planes of the context.
+	//Returns every tile on the path like A* does, or an empty vector if there is no path.
+	std::vector<int> FindPath(SearchContext& Context, int Start, int End) const;
+
+protected:
+	bool IsFree(int x, int y) const
+	{
+		return x >= 0 && y >= 0 && x < Map.Width && y < Map.Height && Map.State[Map.GetIndex(x, y)] != BLOCKED;
+	}
+
+	//Move from (x, y) in the direction (dx, dy) until a jump point or the end tile is found.
+	//Returns the index of the jump point, or -1 if the run ends at an obstacle or the edge of the map.
+	virtual int Jump(int x, int y, int dx, int dy, int End) const;
+	int JumpVertical(int x, int y, int dy, int End) const;
+
+	//Add a jump point to the open list if it has been reached by a shorter path
+	void AddJumpPoint(SearchContext& Context, int From, int JumpPoint, int End) const;
+
+	const TileMap& Map;
+};
@@ -0,0 +1,181 @@
+#include "JumpPointSearchPlus.h"
+#include <cstdlib>
+using std::vector;
+
+void JumpPointSearchPlus::Build()
+{
+	for (int d = 0; d < 4; ++d)
+		Jumps[d].assign(Map.Size(), 0);
+	Reach[UP].assign(Map.Size(), 0);
+	Reach[DOWN].assign(Map.Size(), 0);
+	DirtyRows.assign(Map.Height, 0);
+	ColumnJumps.assign(Map.Height, 0);
+
+	//The rows read the vertical tables, so every column has to be done first
+	for (int x = 0; x < Map.Width; ++x)
+		BuildColumn(x);
+	for (int y = 0; y < Map.Height; ++y)
+		BuildRow(y);
+
+	Built = true;
+}
+
+void JumpPointSearchPlus::BuildColumn(int x)
+{
+	//A vertical run stops where a turn to the side is forced, the same as JumpPointSearch::JumpVertical
+	auto IsForced = [&](int y, int dy)
+	{
+		return (IsFree(x - 1, y) && !IsFree(x - 1, y - dy)) || (IsFree(x + 1, y) && !IsFree(x + 1, y - dy));
+	};
+
+	//Each tile's entry is worked out from the next tile along the run, so walk against the direction
+	for (int y = 0; y < Map.Height; ++y)
+	{
+		int Index = Map.GetIndex(x, y);
+		if (!IsFree(x, y - 1))
+		{
+			Jumps[UP][Index] = 0;
+			Reach[UP][Index] = 0;
+		}
+		else
+		{
+			int Next = Index - Map.Width;
+			int16_t NextJump = Jumps[UP][Next];
+			Jumps[UP][Index] = IsForced(y - 1, -1) ? 1 : (NextJump > 0 ? NextJump + 1 : NextJump - 1);
+			Reach[UP][Index] = Reach[UP][Next] + 1;
+		}
+	}
+
+	for (int y = Map.Height - 1; y >= 0; --y)
+	{
+		int Index = Map.GetIndex(x, y);
+		if (!IsFree(x, y + 1))
+		{
+			Jumps[DOWN][Index] = 0;
+			Reach[DOWN][Index] = 0;
+		}
+		else
+		{
+			int Next = Index + Map.Width;
+			int16_t NextJump = Jumps[DOWN][Next];
+			Jumps[DOWN][Index] = IsForced(y + 1, 1) ? 1 : (NextJump > 0 ? NextJump + 1 : NextJump - 1);
+			Reach[DOWN][Index] = Reach[DOWN][Next] + 1;
+		}
+	}
+}
+
+void JumpPointSearchPlus::BuildRow(int y)
+{
+	//A horizontal run stops at any tile that has a vertical jump point above or below it
+	for (int x = 0; x < Map.Width; ++x)
+	{
+		int Index = Map.GetIndex(x, y);
+		if (!IsFree(x - 1, y))
+		{
+			Jumps[LEFT][Index] = 0;
+		}
+		else
+		{
+			int16_t NextJump = Jumps[LEFT][Index - 1];
+			Jumps[LEFT][Index] = HasVerticalJump(Index - 1) ? 1 : (NextJump > 0 ? NextJump + 1 : NextJump - 1);
+		}
+	}
+
+	for (int x = Map.Width - 1; x >= 0; --x)
+	{
+		int Index = Map.GetIndex(x, y);
+		if (!IsFree(x + 1, y))
+		{
+			Jumps[RIGHT][Index] = 0;
+		}
+		else
+		{
+			int16_t NextJump = Jumps[RIGHT][Index + 1];
+			Jumps[RIGHT][Index] = HasVerticalJump(Index + 1) ? 1 : (NextJump > 0 ? NextJump + 1 : NextJump - 1);
+		}
+	}
+}
+
+void JumpPointSearchPlus::TileChanged(int Index)
+{
+	if (!Built)
+		return;
+
+	int x = Map.GetX(Index);
+	int y = Map.GetY(Index);
+
+	//The tile's own row always changes. Other rows only change where a vertical jump point appeared or disappeared.
+	DirtyRows[y] = 1;
+	for (int Column = x - 1; Column <= x + 1; ++Column)
+	{
+		if (Column < 0 || Column >= Map.Width)
+			continue;
+
+		for (int Row = 0; Row < Map.Height; ++Row)
+			ColumnJumps[Row] = HasVerticalJump(Map.GetIndex(Column, Row));
+
+		BuildColumn(Column);
+
+		for (int Row = 0; Row < Map.Height; ++Row)
+		{
+			if (ColumnJumps[Row] != HasVerticalJump(Map.GetIndex(Column, Row)))
+				DirtyRows[Row] = 1;
+		}
+	}
+
+	for (int Row = 0; Row < Map.Height; ++Row)
+	{
+		if (DirtyRows[Row])
+		{
+			BuildRow(Row);
+			DirtyRows[Row] = 0;
+		}
+	}
+}
+
+int JumpPointSearchPlus::Jump(int x, int y, int dx, int dy, int End) const
+{
+	int Index = Map.GetIndex(x, y);
+	int EndX = Map.GetX(End);
+	int EndY = Map.GetY(End);
+
+	if (dy != 0)
+	{
+		Direction Dir = dy < 0 ? UP : DOWN;
+		int Distance = Jumps[Dir][Index];
+
+		//The goal is on this run if it is in the same column and closer than the first obstacle
+		int GoalDistance = (EndY - y) * dy;
+		if (EndX == x && GoalDistance > 0 && GoalDistance <= Reach[Dir][Index] && (Distance <= 0 || GoalDistance < Distance))
+			return End;
+
+		return Distance > 0 ? Index + Distance * dy * Map.Width : -1;
+	}
+
+	Direction Dir = dx < 0 ? LEFT : RIGHT;
+	int Distance = Jumps[Dir][Index];
+	int RunLength = Distance > 0 ? Distance : -Distance;
+
+	//The run also stops at the goal's column if the goal can be reached by turning up or down there
+	int GoalDistance = (EndX - x) * dx;
+	if (GoalDistance > 0 && GoalDistance <= RunLength && (Distance <= 0 || GoalDistance < Distance))
+	{
+		int Turn = Index + GoalDistance * dx;
+		if (EndY == y)
+			return End;
+		if (EndY < y && Reach[UP][Turn] >= y - EndY)
+			return Turn;
+		if (EndY > y && Reach[DOWN][Turn] >= EndY - y)
+			return Turn;
+	}
+
+	return Distance > 0 ? Index + Distance * dx : -1;
+}
+
+vector<int> JumpPointSearchPlus::FindPath(SearchContext& Context, int Start, int End)
+{
+	if (!Built)
+		Build();
+
+	return JumpPointSearch::FindPath(Context, Start, End);
+}
@@ -0,0 +1,76 @@
+/**********************************************************
+* Description: JPS+, Jump Point Search with the jumps worked
+* out ahead of time.
+*
+* For every tile and each of the four directions, a table
+* stores how far away the next jump point is, or how far the
+* tile can see before it reaches an obstacle. A query reads the
+* tables instead of walking the runs again, and only has to
+* check whether the goal is on the run it is looking at.
+*
+* The tables follow the same rules as JumpPointSearch. A
+* vertical jump point only depends on its own column and the
+* two next to it, and a horizontal one only depends on the
+* vertical tables of its row, so toggling one tile only
+* recomputes three columns and the rows whose vertical jump
+* points changed.
+*
+* Distances are stored in 16 bits, so the map can be at most
+* 32767 tiles wide or high.
+**********************************************************/
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "JumpPointSearch.h"
+
+class JumpPointSearchPlus : public JumpPointSearch
+{
+public:
+	JumpPointSearchPlus(const TileMap& _Map) : JumpPointSearch(_Map) {}
+
+	//Compute the jump tables for the whole map
+	void Build();
+
+	//Update the jump tables after a tile switched between blocked and not blocked
+	void TileChanged(int Index);
+
+	//Find the shortest path from Start to End, building the tables first if they haven't been built yet.
+	//Searches from several threads at once need the tables to have been built already.
+	std::vector<int> FindPath(SearchContext& Context, int Start, int End);
+
+	bool IsBuilt() const { return Built; }
+
+protected:
+	int Jump(int x, int y, int dx, int dy, int End) const override;
+
+private:
+	enum Direction
+	{
+		UP = 0,
+		DOWN,
+		LEFT,
+		RIGHT
+	};
+
+	bool HasVerticalJump(int Index) const
+	{
+		return Jumps[UP][Index] > 0 || Jumps[DOWN][Index] > 0;
+	}
+
+	void BuildColumn(int x);
+	void BuildRow(int y);
+
+	bool Built = false;
+
+	//Jumps[Dir][Index] > 0 is the distance to the next jump point in that direction.
+	//Jumps[Dir][Index] <= 0 is the negated number of empty tiles before the run hits an obstacle.
+	std::vector<int16_t> Jumps[4];
+
+	//Number of empty tiles above and below each tile. A vertical run keeps going past its
+	//jump points, so this is needed to tell whether the goal is on the run.
+	std::vector<int16_t> Reach[2];
+
+	//Scratch space for TileChanged
+	std::vector<char> DirtyRows;
+	std::vector<char> ColumnJumps;
+};
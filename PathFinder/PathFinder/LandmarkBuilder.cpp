@@ -0,0 +1,75 @@
+#include "LandmarkBuilder.h"
+using std::vector;
+
+LandmarkBuilder::~LandmarkBuilder()
+{
+	if (!Worker.joinable())
+		return;
+
+	{
+		std::lock_guard<std::mutex> Guard(Lock);
+		Stopping = true;
+	}
+	Wake.notify_one();
+	Worker.join();
+}
+
+void LandmarkBuilder::Start(const TileMap& Map, int LandmarkCount)
+{
+	WorkerMap = Map;
+	Count = LandmarkCount;
+
+	//The first table has to be built before there are any edits, so count the start as one
+	EditCount = 1;
+	Worker = std::thread(&LandmarkBuilder::Run, this);
+}
+
+void LandmarkBuilder::TileChanged(int Index, TileState NewState)
+{
+	if (!IsStarted())
+		return;
+
+	{
+		std::lock_guard<std::mutex> Guard(Lock);
+		Edits.push_back({ Index, NewState });
+		++EditCount;
+	}
+	Wake.notify_one();
+}
+
+std::shared_ptr<const LandmarkTable> LandmarkBuilder::GetTable()
+{
+	std::lock_guard<std::mutex> Guard(Lock);
+	if (TableEdits != EditCount)
+		return nullptr;
+	return Table;
+}
+
+void LandmarkBuilder::Run()
+{
+	while (true)
+	{
+		unsigned Building;
+		{
+			std::unique_lock<std::mutex> Guard(Lock);
+			Wake.wait(Guard, [this] { return Stopping || TableEdits != EditCount; });
+			if (Stopping)
+				return;
+
+			Building = EditCount;
+			Applying.swap(Edits);
+		}
+
+		//Bring the worker's map up to date with every edit so far, then find the landmarks again
+		for (const Edit& e : Applying)
+			WorkerMap.State[e.Index] = e.NewState;
+		Applying.clear();
+
+		std::shared_ptr<LandmarkTable> Built = std::make_shared<LandmarkTable>();
+		Built->Build(WorkerMap, Count);
+
+		std::lock_guard<std::mutex> Guard(Lock);
+		Table = Built;
+		TableEdits = Building;
+	}
+}
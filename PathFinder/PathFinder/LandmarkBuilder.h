@@ -0,0 +1,66 @@
+/**********************************************************
+* Description: Keeps a LandmarkTable up to date on a worker
+* thread, so changing tiles never waits for the landmarks to
+* be found again.
+*
+* The worker keeps its own copy of the map. Edits are queued
+* with TileChanged, and every edit makes the current table
+* stale. The worker applies all the edits that have piled up at
+* once and builds a new table for the grid as it is after them.
+* A table is handed out only while no edit has arrived since it
+* was started, so a search either gets a table that matches the
+* grid or none at all and falls back to Manhattan distance.
+*
+* Tables are shared, so a search that got one can keep using it
+* after the worker has replaced it.
+**********************************************************/
+#pragma once
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "TileMap.h"
+#include "LandmarkTable.h"
+
+class LandmarkBuilder
+{
+public:
+	~LandmarkBuilder();
+
+	//Copy the map and start building its first table with LandmarkCount landmarks
+	void Start(const TileMap& Map, int LandmarkCount = 8);
+
+	bool IsStarted() const { return Worker.joinable(); }
+
+	//Queue a tile's new state for the worker's map. Does nothing if the builder hasn't been started.
+	void TileChanged(int Index, TileState NewState);
+
+	//The table for the grid as it is now, or nothing while it is still being built
+	std::shared_ptr<const LandmarkTable> GetTable();
+
+private:
+	struct Edit
+	{
+		int Index;
+		TileState NewState;
+	};
+
+	void Run();
+
+	std::thread Worker;
+	std::mutex Lock;
+	std::condition_variable Wake;
+
+	//Shared with the worker. Only used while Lock is held.
+	bool Stopping = false;
+	std::vector<Edit> Edits;
+	unsigned EditCount = 0; //Edits queued so far
+	std::shared_ptr<const LandmarkTable> Table;
+	unsigned TableEdits = 0; //How many edits the table has seen
+
+	//Only used by the worker
+	TileMap WorkerMap;
+	int Count = 0;
+	std::vector<Edit> Applying;
+};
@@ -0,0 +1,106 @@
+#include "LandmarkTable.h"
+#include <algorithm>
+using std::vector;
+
+void LandmarkTable::Build(const TileMap& Map, int LandmarkCount)
+{
+	Landmarks.clear();
+	Stride = LandmarkCount;
+	Distances.assign((size_t)Map.Size() * Stride, UINT32_MAX);
+	Nearest.assign(Map.Size(), UINT32_MAX);
+
+	//Areas this small are searched quickly anyway, so they don't get a landmark.
+	//Their tiles are marked as if they had one already, so they are never picked.
+	int SmallestArea = std::max(1, Map.Size() / 64);
+	vector<uint8_t> Seen(Map.Size(), 0);
+	for (int i = 0; i < Map.Size(); ++i)
+	{
+		if (Map.State[i] == BLOCKED || Seen[i])
+			continue;
+
+		Queue.clear();
+		Queue.push_back(i);
+		Seen[i] = 1;
+		for (size_t Head = 0; Head < Queue.size(); ++Head)
+		{
+			int Neighbors[4];
+			int Count = Map.GetNeighbors(Queue[Head], Neighbors);
+			for (int n = 0; n < Count; ++n)
+			{
+				if (!Seen[Neighbors[n]])
+				{
+					Seen[Neighbors[n]] = 1;
+					Queue.push_back(Neighbors[n]);
+				}
+			}
+		}
+
+		if ((int)Queue.size() < SmallestArea)
+		{
+			for (int t : Queue)
+				Nearest[t] = 0;
+		}
+	}
+
+	while ((int)Landmarks.size() < LandmarkCount)
+	{
+		//The next landmark is the tile farthest from every landmark so far. Tiles none of them reach come first.
+		int Farthest = -1;
+		for (int t = 0; t < Map.Size(); ++t)
+		{
+			if (Map.State[t] != BLOCKED && (Farthest == -1 || Nearest[t] > Nearest[Farthest]))
+				Farthest = t;
+		}
+
+		//Stop early when every tile is a landmark or in an area too small for one
+		if (Farthest == -1 || Nearest[Farthest] == 0)
+			break;
+
+		int Column = (int)Landmarks.size();
+		if (Nearest[Farthest] == UINT32_MAX)
+		{
+			//The first landmark of an area goes on its edge, at the tile farthest from where the area was found
+			Spread(Map, Farthest, Column);
+			Farthest = Queue.back();
+			for (int t : Queue)
+			{
+				Distances[(size_t)t * Stride + Column] = UINT32_MAX;
+				Nearest[t] = UINT32_MAX;
+			}
+		}
+
+		Landmarks.push_back(Farthest);
+		Spread(Map, Farthest, Column);
+	}
+
+	Nearest = vector<uint32_t>();
+	Queue = vector<int>();
+}
+
+void LandmarkTable::Spread(const TileMap& Map, int Landmark, int Column)
+{
+	Queue.clear();
+	Queue.push_back(Landmark);
+	Distances[(size_t)Landmark * Stride + Column] = 0;
+	Nearest[Landmark] = 0;
+
+	for (size_t Head = 0; Head < Queue.size(); ++Head)
+	{
+		int t = Queue[Head];
+		uint32_t Next = Distances[(size_t)t * Stride + Column] + 1;
+		int Neighbors[4];
+		int Count = Map.GetNeighbors(t, Neighbors);
+		for (int i = 0; i < Count; ++i)
+		{
+			int n = Neighbors[i];
+			uint32_t& Distance = Distances[(size_t)n * Stride + Column];
+			if (Distance != UINT32_MAX)
+				continue;
+
+			Distance = Next;
+			if (Next < Nearest[n])
+				Nearest[n] = Next;
+			Queue.push_back(n);
+		}
+	}
+}
@@ -0,0 +1,64 @@
+/**********************************************************
+* Description: Landmark distances for the ALT heuristic (A*,
+* landmarks, triangle inequality).
+*
+* A few tiles are picked as landmarks, and the exact distance
+* from each landmark to every tile is stored. For any landmark
+* L, the distance from a tile to the end tile is at least
+* |d(L, end) - d(L, tile)|, because going through the tile
+* can't make the trip from L shorter. The biggest of these over
+* all landmarks is an estimate that never overshoots and, unlike
+* Manhattan distance, knows about walls. On mazes it can be many
+* times closer to the real distance.
+*
+* Landmarks are picked far apart: each new one is the tile
+* farthest from the landmarks picked so far. A tile that none
+* of them can reach counts as the farthest, so every area of
+* the map gets a landmark while there are some left, except
+* areas too small to need one.
+*
+* A table is only correct for the grid it was built from.
+**********************************************************/
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include "TileMap.h"
+
+class LandmarkTable
+{
+public:
+	//Pick up to LandmarkCount landmarks and find the distances from each of them to every tile
+	void Build(const TileMap& Map, int LandmarkCount);
+
+	//The lower bound on the distance between two tiles. Landmarks that can't reach both tiles are left out.
+	int GetBound(int From, int To) const
+	{
+		const uint32_t* a = &Distances[(size_t)From * Stride];
+		const uint32_t* b = &Distances[(size_t)To * Stride];
+		int Bound = 0;
+		for (int k = 0; k < (int)Landmarks.size(); ++k)
+		{
+			if (a[k] != UINT32_MAX && b[k] != UINT32_MAX)
+			{
+				int Difference = abs((int)a[k] - (int)b[k]);
+				Bound = Difference > Bound ? Difference : Bound;
+			}
+		}
+		return Bound;
+	}
+
+	const std::vector<int>& GetLandmarks() const { return Landmarks; }
+
+private:
+	//Breadth first search from a landmark, filling its column of Distances and lowering Nearest
+	void Spread(const TileMap& Map, int Landmark, int Column);
+
+	std::vector<int> Landmarks;
+	int Stride = 0; //Distances of one tile to every landmark are next to each other, so a lookup reads one cache line
+	std::vector<uint32_t> Distances; //UINT32_MAX where the landmark can't reach the tile
+
+	//Only used while building
+	std::vector<uint32_t> Nearest; //Distance from each tile to the closest landmark picked so far
+	std::vector<int> Queue;
+};
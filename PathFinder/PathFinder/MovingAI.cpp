@@ -0,0 +1,68 @@
+#include "MovingAI.h"
+#include <fstream>
+#include <sstream>
+using std::string;
+using std::vector;
+
+bool LoadMovingAIMap(const string& FileName, TileMap& Map)
+{
+	std::ifstream File(FileName);
+	if (!File)
+		return false;
+
+	//The header is "type octile", then the height and width in either order, then "map"
+	int Width = 0;
+	int Height = 0;
+	string Word;
+	while (File >> Word && Word != "map")
+	{
+		if (Word == "height")
+			File >> Height;
+		else if (Word == "width")
+			File >> Width;
+		else if (Word == "type")
+			File >> Word;
+		else
+			return false;
+	}
+	if (Word != "map" || Width <= 0 || Height <= 0)
+		return false;
+
+	Map.Create(Width, Height);
+	string Row;
+	for (int y = 0; y < Height; ++y)
+	{
+		if (!(File >> Row) || (int)Row.size() < Width)
+			return false;
+
+		for (int x = 0; x < Width; ++x)
+		{
+			char c = Row[x];
+			Map.State[Map.GetIndex(x, y)] = c == '.' || c == 'G' || c == 'S' ? EMPTY : BLOCKED;
+		}
+	}
+	return true;
+}
+
+bool LoadMovingAIScenarios(const string& FileName, vector<Scenario>& Scenarios)
+{
+	std::ifstream File(FileName);
+	if (!File)
+		return false;
+
+	string Line;
+	if (!std::getline(File, Line) || Line.compare(0, 7, "version") != 0)
+		return false;
+
+	//Each line is: bucket, map, map width, map height, start x, start y, end x, end y, optimal length
+	while (std::getline(File, Line))
+	{
+		std::istringstream Fields(Line);
+		Scenario New;
+		if (Fields >> New.Bucket >> New.MapName >> New.MapWidth >> New.MapHeight >> New.StartX >> New.StartY >> New.EndX >> New.EndY >> New.OptimalCost)
+			Scenarios.push_back(New);
+		else if (Line.find_first_not_of(" \t\r") != string::npos)
+			return false;
+	}
+	return true;
+}
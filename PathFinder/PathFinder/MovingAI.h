@@ -0,0 +1,34 @@
+/**********************************************************
+* Description: Reads the map and scenario files of the MovingAI
+* grid benchmarks (movingai.com/benchmarks), so the engines can
+* be compared on the same maps as other path finders.
+*
+* A .map file is a grid of characters. '.', 'G' and 'S' can be
+* walked on. Trees, water and out of bounds tiles are blocked.
+* A .scen file lists start and end tiles along with the length
+* of the shortest path. The benchmarks allow diagonal steps, so
+* that length is not the one these 4 direction engines find.
+**********************************************************/
+#pragma once
+#include <vector>
+#include <string>
+#include "TileMap.h"
+
+struct Scenario
+{
+	int Bucket = 0; //Scenarios are grouped by how long their paths are
+	std::string MapName;
+	int MapWidth = 0;
+	int MapHeight = 0;
+	int StartX = 0;
+	int StartY = 0;
+	int EndX = 0;
+	int EndY = 0;
+	double OptimalCost = 0; //With diagonal steps costing the square root of 2
+};
+
+//Load a .map file into Map. Returns false if the file can't be read or isn't a map.
+bool LoadMovingAIMap(const std::string& FileName, TileMap& Map);
+
+//Add the scenarios in a .scen file to Scenarios. Returns false if the file can't be read or isn't a scenario file.
+bool LoadMovingAIScenarios(const std::string& FileName, std::vector<Scenario>& Scenarios);
@@ -0,0 +1,47 @@
+#include "PathCheck.h"
+#include <cstdlib>
+using std::vector;
+
+int FindShortestLength(const TileMap& Map, int Start, int End, vector<int>& Distances, vector<int>& Queue)
+{
+	if (Map.State[Start] == BLOCKED || Map.State[End] == BLOCKED)
+		return -1;
+
+	Distances.assign(Map.Size(), -1);
+	Queue.assign(1, Start);
+	Distances[Start] = 0;
+	for (size_t Head = 0; Head < Queue.size(); ++Head)
+	{
+		int t = Queue[Head];
+		if (t == End)
+			return Distances[t];
+
+		int Neighbors[4];
+		int Count = Map.GetNeighbors(t, Neighbors);
+		for (int i = 0; i < Count; ++i)
+		{
+			int n = Neighbors[i];
+			if (Distances[n] == -1)
+			{
+				Distances[n] = Distances[t] + 1;
+				Queue.push_back(n);
+			}
+		}
+	}
+	return -1;
+}
+
+bool IsValidPath(const TileMap& Map, const vector<int>& Path, int Start, int End)
+{
+	if (Path.empty() || Path.front() != Start || Path.back() != End)
+		return false;
+
+	for (size_t i = 0; i < Path.size(); ++i)
+	{
+		if (Path[i] < 0 || Path[i] >= Map.Size() || Map.State[Path[i]] == BLOCKED)
+			return false;
+		if (i > 0 && abs(Map.GetX(Path[i]) - Map.GetX(Path[i - 1])) + abs(Map.GetY(Path[i]) - Map.GetY(Path[i - 1])) != 1)
+			return false;
+	}
+	return true;
+}
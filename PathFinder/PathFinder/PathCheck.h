@@ -0,0 +1,21 @@
+/**********************************************************
+* Description: The plain way to check what an engine found,
+* for the benchmark and the tests. A breadth first search gives
+* the length of the shortest path, since every step costs the
+* same, and a path is only a path if it goes from the start
+* tile to the end tile one step at a time through tiles that
+* aren't blocked.
+*
+* These are kept simple rather than fast, since they are what
+* the engines are measured against.
+**********************************************************/
+#pragma once
+#include <vector>
+#include "TileMap.h"
+
+//Length of the shortest 4 direction path from Start to End, or -1 if there is none.
+//Distances and Queue are space for the search, so many searches can reuse their memory.
+int FindShortestLength(const TileMap& Map, int Start, int End, std::vector<int>& Distances, std::vector<int>& Queue);
+
+//True if Path goes from Start to End through tiles that aren't blocked, each next to the one before
+bool IsValidPath(const TileMap& Map, const std::vector<int>& Path, int Start, int End);
@@ -0,0 +1,181 @@
+#include "PathDatabase.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+using std::vector;
+
+//Moves 0 to 3 are up, down, left and right, in the same order as Steps.
+//While building, each tile keeps the set of first moves that start a shortest path to it, one bit per move.
+const uint8_t NO_MOVES = 0; //Tile not reached by the search, or the source itself
+
+void PathDatabase::Build(int ThreadCount)
+{
+	auto BuildStart = std::chrono::steady_clock::now();
+	int TileCount = Map.Size();
+	int Steps[4] = { -Map.Width, Map.Width, -1, 1 };
+
+	//Number the tiles in the order a depth first walk visits them
+	Walk.clear();
+	Positions.assign(TileCount, UINT32_MAX);
+	vector<int> Stack;
+	for (int i = 0; i < TileCount; ++i)
+	{
+		if (Map.State[i] == BLOCKED || Positions[i] != UINT32_MAX)
+			continue;
+
+		Stack.push_back(i);
+		while (!Stack.empty())
+		{
+			int t = Stack.back();
+			Stack.pop_back();
+			if (Positions[t] != UINT32_MAX)
+				continue;
+
+			Positions[t] = (uint32_t)Walk.size();
+			Walk.push_back(t);
+
+			//Pushed in reverse so the walk goes up, down, left, right
+			int x = Map.GetX(t);
+			int y = Map.GetY(t);
+			bool Inside[4] = { y > 0, y < Map.Height - 1, x > 0, x < Map.Width - 1 };
+			for (int d = 3; d >= 0; --d)
+			{
+				int n = t + Steps[d];
+				if (Inside[d] && Map.State[n] != BLOCKED && Positions[n] == UINT32_MAX)
+					Stack.push_back(n);
+			}
+		}
+	}
+
+	//Every source is searched on its own, so the sources are shared out between threads
+	if (ThreadCount <= 0)
+		ThreadCount = std::max(1, (int)std::thread::hardware_concurrency());
+	vector<vector<uint32_t>> SourceRuns(TileCount);
+	std::atomic<int> NextSource{ 0 };
+	auto Work = [&]()
+	{
+		vector<uint8_t> Moves(TileCount);
+		vector<uint32_t> Distances(TileCount);
+		vector<int> Queue;
+		Queue.reserve(TileCount);
+		for (int s = NextSource++; s < TileCount; s = NextSource++)
+		{
+			if (Map.State[s] != BLOCKED)
+				BuildSource(s, Moves, Distances, Queue, SourceRuns[s]);
+		}
+	};
+	vector<std::thread> Threads;
+	for (int i = 1; i < ThreadCount; ++i)
+		Threads.emplace_back(Work);
+	Work();
+	for (std::thread& t : Threads)
+		t.join();
+
+	//Put every source's runs one after another
+	Offsets.assign(TileCount + 1, 0);
+	for (int s = 0; s < TileCount; ++s)
+		Offsets[s + 1] = Offsets[s] + SourceRuns[s].size();
+	Runs.resize((size_t)Offsets[TileCount]);
+	for (int s = 0; s < TileCount; ++s)
+		std::copy(SourceRuns[s].begin(), SourceRuns[s].end(), Runs.begin() + (size_t)Offsets[s]);
+
+	Built = true;
+	BuildMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - BuildStart).count();
+}
+
+void PathDatabase::BuildSource(int Source, vector<uint8_t>& Moves, vector<uint32_t>& Distances, vector<int>& Queue, vector<uint32_t>& SourceRuns) const
+{
+	int Steps[4] = { -Map.Width, Map.Width, -1, 1 };
+
+	//Breadth first search from the source. A tile gets the first moves of every tile one step closer that it is next to.
+	std::fill(Moves.begin(), Moves.end(), NO_MOVES);
+	Queue.clear();
+	Queue.push_back(Source);
+	Distances[Source] = 0;
+	for (size_t Head = 0; Head < Queue.size(); ++Head)
+	{
+		int t = Queue[Head];
+		int x = Map.GetX(t);
+		int y = Map.GetY(t);
+		bool Inside[4] = { y > 0, y < Map.Height - 1, x > 0, x < Map.Width - 1 };
+		for (int d = 0; d < 4; ++d)
+		{
+			int n = t + Steps[d];
+			if (!Inside[d] || Map.State[n] == BLOCKED || n == Source)
+				continue;
+
+			uint8_t Inherited = t == Source ? (uint8_t)(1 << d) : Moves[t];
+			if (Moves[n] == NO_MOVES)
+			{
+				Moves[n] = Inherited;
+				Distances[n] = Distances[t] + 1;
+				Queue.push_back(n);
+			}
+			else if (Distances[n] == Distances[t] + 1)
+			{
+				Moves[n] |= Inherited;
+			}
+		}
+	}
+
+	//A run goes on for as long as one move is shortest for all of its tiles. Tiles that weren't reached fit into any run.
+	SourceRuns.clear();
+	uint32_t RunStart = 0;
+	uint8_t RunMoves = NO_MOVES;
+	for (size_t Position = 0; Position < Walk.size(); ++Position)
+	{
+		uint8_t TileMoves = Moves[Walk[Position]];
+		if (TileMoves == NO_MOVES)
+			continue;
+
+		if ((RunMoves & TileMoves) != 0)
+		{
+			RunMoves &= TileMoves;
+			continue;
+		}
+
+		//The first run covers everything before it as well
+		if (RunMoves != NO_MOVES)
+			AddRun(SourceRuns, RunStart, RunMoves);
+		RunStart = SourceRuns.empty() ? 0 : (uint32_t)Position;
+		RunMoves = TileMoves;
+	}
+	if (RunMoves != NO_MOVES)
+		AddRun(SourceRuns, RunStart, RunMoves);
+	SourceRuns.shrink_to_fit();
+}
+
+void PathDatabase::AddRun(vector<uint32_t>& SourceRuns, uint32_t RunStart, uint8_t RunMoves)
+{
+	//Any move left in the set will do, so the lowest one is stored. It may carry on the run before.
+	uint32_t Move = 0;
+	while (!(RunMoves & (1 << Move)))
+		++Move;
+	if (SourceRuns.empty() || (SourceRuns.back() & 3) != Move)
+		SourceRuns.push_back((RunStart << 2) | Move);
+}
+
+vector<int> PathDatabase::FindPath(int Start, int End) const
+{
+	vector<int> Path;
+	if (Map.State[Start] == BLOCKED || Map.State[End] == BLOCKED)
+		return Path;
+
+	int Steps[4] = { -Map.Width, Map.Width, -1, 1 };
+	uint32_t Key = (Positions[End] << 2) | 3;
+	Path.push_back(Start);
+	for (int t = Start; t != End; Path.push_back(t))
+	{
+		//Every run joins in tiles that can't be reached, so a path that is going nowhere has to be stopped
+		const uint32_t* First = Runs.data() + Offsets[t];
+		const uint32_t* Last = Runs.data() + Offsets[t + 1];
+		if (First == Last || (int)Path.size() > (int)Walk.size())
+			return vector<int>(); //Return empty path if it cannot be found
+
+		//The run holding the end tile is the last one that starts at or before it
+		uint32_t Run = *(std::upper_bound(First, Last, Key) - 1);
+		t += Steps[Run & 3];
+	}
+	return Path;
+}
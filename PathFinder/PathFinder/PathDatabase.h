@@ -0,0 +1,64 @@
+/**********************************************************
+* Description: A Compressed Path Database (CPD). For every
+* pair of tiles it knows which way to step first to get from
+* one to the other along a shortest path, so a path is found
+* by stepping that way over and over, without searching.
+*
+* Building it runs a breadth first search from every tile,
+* spread over every core. The first moves from one tile to
+* all the others are stored in the order a depth first walk of
+* the map visits the tiles. Tiles close together in that order
+* are usually close on the map too, and are reached by the same
+* first move, so long runs of the same move are stored as one
+* entry: where the run starts and the move. Often more than one
+* first move is shortest, and a run keeps going for as long as
+* one move is shortest for all its tiles. Tiles that can't be
+* reached never get asked about, so they join any run.
+*
+* A query looks up each step with a binary search over the runs
+* of the tile it is on. The database is for maps that don't
+* change. Changing a tile throws it away, and it is only built
+* again when it is next needed.
+**********************************************************/
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "TileMap.h"
+
+class PathDatabase
+{
+public:
+	PathDatabase(const TileMap& _Map) : Map(_Map) {}
+
+	//Find the first moves between every pair of tiles, using ThreadCount threads or one for every core if it is 0
+	void Build(int ThreadCount = 0);
+
+	//Throw the database away after a tile switched between blocked and not blocked
+	void TileChanged(int) { Built = false; }
+
+	bool IsBuilt() const { return Built; }
+
+	//Follow the first moves from Start to End. Returns an empty path if there is none.
+	std::vector<int> FindPath(int Start, int End) const;
+
+	//How much memory the runs take
+	size_t GetSizeBytes() const { return Runs.size() * sizeof(uint32_t) + Offsets.size() * sizeof(uint64_t) + Positions.size() * sizeof(uint32_t); }
+
+	double GetBuildMilliseconds() const { return BuildMilliseconds; }
+
+private:
+	//The first moves from Source to every tile, compressed into runs
+	void BuildSource(int Source, std::vector<uint8_t>& Moves, std::vector<uint32_t>& Distances, std::vector<int>& Queue, std::vector<uint32_t>& SourceRuns) const;
+
+	//Add a run that can use any of RunMoves
+	static void AddRun(std::vector<uint32_t>& SourceRuns, uint32_t RunStart, uint8_t RunMoves);
+
+	const TileMap& Map;
+	bool Built = false;
+	double BuildMilliseconds = 0;
+	std::vector<int> Walk; //Tiles that aren't blocked, in the order of a depth first walk of the map
+	std::vector<uint32_t> Positions; //Where each tile is in Walk
+	std::vector<uint64_t> Offsets; //The runs of tile s are Runs[Offsets[s]] up to Runs[Offsets[s + 1]]
+	std::vector<uint32_t> Runs; //Position in Walk where the run starts times 4, plus the move
+};
@@ -0,0 +1,113 @@
+#include "PathSolver.h"
+#include "AStar.h"
+#include "AnytimeSearch.h"
+#include "Trace.h"
+#include <chrono>
+using std::vector;
+
+void PathSolver::Prepare(SearchEngine Engine)
+{
+	if (!Components.IsBuilt())
+		Components.Build();
+
+	switch (Engine)
+	{
+	case JPSPLUS:
+		if (!JumpSearchPlus.IsBuilt())
+			JumpSearchPlus.Build();
+		break;
+	case HPA:
+		if (!ClusterSearch.IsBuilt())
+			ClusterSearch.Build();
+		break;
+	case BITBOARD:
+		if (!WaveSearch.IsBuilt())
+			WaveSearch.Build();
+		break;
+	case ASTARLANDMARKS:
+		if (!Landmarks.IsStarted())
+			Landmarks.Start(Map);
+		break;
+	case CPD:
+		if (!Database.IsBuilt())
+			Database.Build();
+		break;
+	default:
+		break;
+	}
+}
+
+void PathSolver::TileChanged(int Index)
+{
+	JumpSearchPlus.TileChanged(Index);
+	ClusterSearch.TileChanged(Index);
+	Replanner.TileChanged(Index);
+	WaveSearch.TileChanged(Index);
+	Field.TileChanged(Index);
+	Landmarks.TileChanged(Index, Map.State[Index]);
+	Database.TileChanged(Index);
+	Components.TileChanged(Index);
+}
+
+vector<int> PathSolver::FindPath(SearchContext& Context, SearchEngine Engine, int Start, int End, double* Bound)
+{
+	TraceZone Zone("FindPath");
+
+	//Engines that don't use the context leave the counts at 0 instead of showing the last search's
+	auto SearchStart = std::chrono::steady_clock::now();
+	Context.Stats = SearchStats();
+	vector<int> Path = RunEngine(Context, Engine, Start, End, Bound);
+	Context.Stats.PathLength = (int)Path.size();
+	Context.Stats.Microseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - SearchStart).count();
+	return Path;
+}
+
+vector<int> PathSolver::RunEngine(SearchContext& Context, SearchEngine Engine, int Start, int End, double* Bound)
+{
+	if (Bound)
+		*Bound = Engine == HPA ? 0 : 1;
+
+	//When the start and end tiles are walled off from each other there is nothing to search for
+	if (!Connected(Start, End))
+		return vector<int>();
+
+	switch (Engine)
+	{
+	case ASTARBUCKETS:
+		return FindPathAStar(Map, Context, Context.OpenBuckets, Start, End);
+	case JPS:
+		return JumpSearch.FindPath(Context, Start, End);
+	case JPSPLUS:
+		return JumpSearchPlus.FindPath(Context, Start, End);
+	case HPA:
+		return ClusterSearch.FindPath(Context, Start, End);
+	case DSTARLITE:
+		return Replanner.FindPath(Start, End);
+	case BITBOARD:
+		return WaveSearch.FindPath(Context, Start, End);
+	case ASTARLANDMARKS:
+	{
+		//Holding on to the table keeps it alive even if the builder replaces it during the search
+		std::shared_ptr<const LandmarkTable> Table = Landmarks.GetTable();
+		return FindPathAStar(Map, Context, Context.OpenList, Start, End, NeverCancel(), Table.get());
+	}
+	case CPD:
+		if (!Database.IsBuilt())
+			Database.Build();
+		return Database.FindPath(Start, End);
+	case BIDIRECTIONAL:
+		return MeetSearch.FindPath(Context, Start, End);
+	case FLOWFIELD:
+		return Field.FindPath(Start, End);
+	case ARASTAR:
+	{
+		AnytimeSearch Anytime(Map, Context);
+		vector<int> Path = Anytime.FindPath(Start, End, AnytimeMicroseconds);
+		if (Bound)
+			*Bound = Anytime.GetBound();
+		return Path;
+	}
+	default:
+		return FindPathAStar(Map, Context, Context.OpenList, Start, End);
+	}
+}
@@ -0,0 +1,94 @@
+/**********************************************************
+* Description: The path finding library in one place, for a
+* program that just wants paths and doesn't need to know how
+* each engine works. It has nothing to do with drawing, so it
+* can be used without a window.
+*
+* A PathSolver owns everything the engines work out ahead of
+* time for one map, and keeps it up to date as tiles change.
+* Searches write only to the SearchContext they are given.
+* Once Prepare has been called for an engine, any number of
+* threads can search with it at the same time, each with its
+* own context, as long as the map isn't being changed. D* Lite
+* keeps its last search to repair it, and bidirectional A* has
+* a helper thread of its own, so only one search at a time can
+* use either of them. The flow field is
+* built for one end tile at a time, so several threads can only
+* use it together once it has been built for the end tile they
+* share.
+**********************************************************/
+#pragma once
+#include <vector>
+#include "TileMap.h"
+#include "SearchContext.h"
+#include "JumpPointSearch.h"
+#include "JumpPointSearchPlus.h"
+#include "HierarchicalSearch.h"
+#include "DStarLite.h"
+#include "ConnectedComponents.h"
+#include "BitboardSearch.h"
+#include "FlowField.h"
+#include "BidirectionalSearch.h"
+#include "LandmarkBuilder.h"
+#include "PathDatabase.h"
+
+enum SearchEngine
+{
+	ASTAR, //Plain A* over every tile
+	ASTARBUCKETS, //A* with a bucket queue for the open list instead of a heap
+	JPS, //Jump Point Search, which skips over straight runs of empty tiles
+	JPSPLUS, //Jump Point Search reading its jumps from precomputed tables
+	HPA, //Hierarchical search over clusters of tiles. Fast on big maps, but not always the shortest path.
+	DSTARLITE, //Incremental search that repairs its last result when tiles change
+	BITBOARD, //Breadth first search that grows 64 tiles at a time using rows of bits
+	ASTARSLICED, //A* spread over several frames with AStarSearch. FindPath runs it all at once.
+	ARASTAR, //Anytime A* that finds a path fast and makes it shorter until its time is up
+	FLOWFIELD, //Distances from every tile to the end tile, found once and followed from any start tile
+	BIDIRECTIONAL, //A* from both ends at once, each on its own thread
+	ASTARLANDMARKS, //A* guided by distances to landmarks, which know about walls. Manhattan distance while they are being rebuilt.
+	CPD //Follows first moves looked up in a Compressed Path Database, without searching
+};
+
+class PathSolver
+{
+public:
+	PathSolver(const TileMap& _Map) : Map(_Map), JumpSearch(_Map), JumpSearchPlus(_Map), ClusterSearch(_Map), Replanner(_Map), WaveSearch(_Map), Field(_Map), MeetSearch(_Map), Database(_Map), Components(_Map) {}
+
+	//Work out everything the engine needs ahead of time. Engines that aren't prepared do it
+	//on their first search, which is fine for one thread but not for several at once.
+	void Prepare(SearchEngine Engine);
+
+	//Update everything that was worked out ahead of time after a tile switched between blocked and not blocked
+	void TileChanged(int Index);
+
+	//False if the two tiles are walled off from each other, which is known without searching
+	bool Connected(int a, int b) const
+	{
+		return !Components.IsBuilt() || Components.Connected(a, b);
+	}
+
+	//Find a path from Start to End with the given engine. Returns an empty path if there is none.
+	//Bound is set to how many times longer than the shortest path the result can be at most.
+	//HPA* sets it to 0, because it can't say.
+	//Context.Stats is left with what the search did. Its time and path length are filled in for every engine,
+	//and the other counts for the engines that search tile by tile in the context.
+	std::vector<int> FindPath(SearchContext& Context, SearchEngine Engine, int Start, int End, double* Bound = nullptr);
+
+	double AnytimeMicroseconds = 1000; //How long ARA* may keep making its path shorter
+
+	const TileMap& Map;
+	JumpPointSearch JumpSearch;
+	JumpPointSearchPlus JumpSearchPlus;
+	HierarchicalSearch ClusterSearch;
+	DStarLite Replanner;
+	BitboardSearch WaveSearch;
+	FlowField Field;
+	BidirectionalSearch MeetSearch;
+	LandmarkBuilder Landmarks; //Started by Prepare, and rebuilt on its own thread after tiles change
+	PathDatabase Database;
+	ConnectedComponents Components; //Which tiles can reach each other, so impossible paths aren't searched for
+
+private:
+	//FindPath without the counting
+	std::vector<int> RunEngine(SearchContext& Context, SearchEngine Engine, int Start, int End, double* Bound);
+};
@@ -0,0 +1,25 @@
+#include "SearchContext.h"
+
+void SearchContext::BeginSearch(int TileCount)
+{
+	//The first search, or a search on a map of a different size, needs new planes
+	if ((int)Generation.size() != TileCount)
+	{
+		G.assign(TileCount, UNREACHED);
+		Parent.assign(TileCount, NO_PARENT);
+		List.assign(TileCount, UNLISTED);
+		Generation.assign(TileCount, 0);
+		SearchGeneration = 0;
+		OpenList.Resize(TileCount);
+		OpenBuckets.Clear();
+	}
+
+	Stats = SearchStats();
+	++SearchGeneration;
+	if (SearchGeneration == 0)
+	{
+		//The counter wrapped around, so old stamps could look current again. Reset them all once.
+		Generation.assign(TileCount, 0);
+		SearchGeneration = 1;
+	}
+}
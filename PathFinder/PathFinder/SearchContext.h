@@ -0,0 +1,115 @@
+/**********************************************************
+* Description: Everything one search writes while it runs,
+* kept apart from the map so many searches can share one map.
+* A thread needs its own context, and a context can be reused
+* for any number of searches one after another.
+*
+* The search planes are indexed like the tiles of the map.
+* They are only meaningful for tiles whose Generation matches
+* SearchGeneration. Every other tile is treated as untouched by
+* the current search, so starting a search doesn't have to
+* clear anything.
+**********************************************************/
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "IndexedHeap.h"
+#include "BucketQueue.h"
+
+enum ListState : uint8_t
+{
+	UNLISTED = 0, //Tile has not been reached by the current search
+	OPENED, //Tile is in the open list
+	CLOSED //Tile has already been searched
+};
+
+const uint32_t NO_PARENT = UINT32_MAX; //Parent of a tile that was not reached from another tile
+const uint32_t UNREACHED = UINT32_MAX; //G value of a tile that the current search has not reached yet
+
+//What the last search in a context did, to see where its time went. Counted by the engines that search tile by tile in the context.
+struct SearchStats
+{
+	int Expanded = 0; //Tiles taken off the open list and searched from
+	int Pushes = 0; //Tiles added to the open list
+	int Reopens = 0; //Tiles searched from again because a shorter way to them was found after they were closed
+	int PeakOpen = 0; //Most tiles in the open list at once
+	int PathLength = 0; //Tiles in the path found, counting the start tile. 0 if there is none.
+	double Microseconds = 0; //Time spent on the search
+
+	//Count a tile added to an open list that now holds OpenSize tiles
+	void CountPush(int OpenSize)
+	{
+		++Pushes;
+		if (OpenSize > PeakOpen)
+			PeakOpen = OpenSize;
+	}
+
+	//Add the counts of another part of the same search. Time and path length are left alone.
+	void Add(const SearchStats& Other)
+	{
+		Expanded += Other.Expanded;
+		Pushes += Other.Pushes;
+		Reopens += Other.Reopens;
+		PeakOpen = Other.PeakOpen > PeakOpen ? Other.PeakOpen : PeakOpen;
+	}
+};
+
+class SearchContext
+{
+public:
+	//Start a new search on a map with TileCount tiles. The search planes of every tile become stale at once, and Stats start over.
+	void BeginSearch(int TileCount);
+
+	//Reset the search planes of a tile the first time the current search reaches it
+	void Touch(int Index)
+	{
+		if (Generation[Index] != SearchGeneration)
+		{
+			G[Index] = UNREACHED;
+			Parent[Index] = NO_PARENT;
+			List[Index] = UNLISTED;
+			Generation[Index] = SearchGeneration;
+		}
+	}
+
+	//Where a tile is in the current search, without touching it
+	ListState GetList(int Index) const
+	{
+		return Generation[Index] == SearchGeneration ? List[Index] : UNLISTED;
+	}
+
+	//Search planes
+	std::vector<uint32_t> G; //Length of the shortest known path from the start tile
+	std::vector<uint32_t> Parent; //Index of the tile this one was reached from
+	std::vector<ListState> List;
+	std::vector<uint16_t> Generation; //The search that last touched each tile
+	uint16_t SearchGeneration = 0;
+
+	//Tiles waiting to be searched. Kept between searches to reuse their memory.
+	IndexedHeap OpenList;
+	BucketQueue OpenBuckets;
+
+	SearchStats Stats;
+
+	//Space the engines search in, each engine with its own so that engines sharing a context can't trip over
+	//each other's sizes. Nothing in here is kept from one search to the next, and each engine sizes what it uses.
+
+	//BitboardSearch
+	std::vector<uint64_t> Unreached; //Tiles that are free and the search hasn't reached yet
+	std::vector<uint64_t> Frontier;
+	std::vector<uint64_t> NextFrontier;
+	std::vector<int> LayerStart;
+	std::vector<int> LayerWords;
+	std::vector<uint64_t> LayerBits;
+
+	//HierarchicalSearch
+	std::vector<int> StartDistances; //Distances inside the cluster of the start tile
+	std::vector<int> EndDistances; //Distances inside the cluster of the end tile
+	std::vector<int> ClusterParents;
+	std::vector<int> ClusterQueue;
+
+	//AnytimeSearch
+	std::vector<int> Closed; //Tiles expanded with the current weight
+	std::vector<int> Inconsistent; //Tiles that got better after they were expanded
+	std::vector<int> Reopened; //Tiles being put back into the open list
+};
@@ -0,0 +1,9 @@
+#include "TileMap.h"
+
+void TileMap::Create(int _Width, int _Height)
+{
+	Width = _Width;
+	Height = _Height;
+
+	State.assign(Size(), EMPTY);
+}
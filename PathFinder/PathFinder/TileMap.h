@@ -0,0 +1,53 @@
+/**********************************************************
+* Description: The grid of tiles. A tile is identified by its
+* index y * Width + x, so its coordinates don't need to be
+* stored and everything else about a tile can be kept in
+* planes (arrays) indexed the same way.
+*
+* The map only holds what the tiles are. Everything a search
+* writes lives in a SearchContext, so any number of searches
+* can read the same map at once, each with its own context.
+**********************************************************/
+#pragma once
+#include <vector>
+#include <cstdint>
+
+enum TileState : uint8_t
+{
+	EMPTY = 0, //Empty tile that can be used for pathing
+	START, //Start of the path
+	BLOCKED, //Obstacle that cannot be used for pathing
+	END, //End of the path
+	PATHED //Empty tile that has been used for pathing
+};
+
+class TileMap
+{
+public:
+	//Make a Width x Height map of empty tiles
+	void Create(int _Width, int _Height);
+
+	int Size() const { return Width * Height; }
+	int GetIndex(int x, int y) const { return y * Width + x; }
+	int GetX(int Index) const { return Index % Width; }
+	int GetY(int Index) const { return Index / Width; }
+
+	//Fills Neighbors with the tiles next to Index that aren't blocked and returns how many there are
+	int GetNeighbors(int Index, int Neighbors[4]) const
+	{
+		int x = GetX(Index);
+		int y = GetY(Index);
+		int Count = 0;
+		if (y > 0 && State[Index - Width] != BLOCKED) Neighbors[Count++] = Index - Width;
+		if (y < Height - 1 && State[Index + Width] != BLOCKED) Neighbors[Count++] = Index + Width;
+		if (x > 0 && State[Index - 1] != BLOCKED) Neighbors[Count++] = Index - 1;
+		if (x < Width - 1 && State[Index + 1] != BLOCKED) Neighbors[Count++] = Index + 1;
+		return Count;
+	}
+
+	int Width = 0;
+	int Height = 0;
+
+	//Tile plane
+	std::vector<TileState> State;
+};
@@ -0,0 +1,99 @@
+#include "Trace.h"
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+using std::string;
+using std::vector;
+
+bool TracingOn = false;
+
+struct TraceEvent
+{
+	const char* Name;
+	double Start; //Microseconds since tracing started
+	double Duration;
+	int Thread;
+};
+
+//A long session can make a lot of zones. Past this many, new ones are dropped instead of using up memory.
+const size_t MAX_EVENTS = 4000000;
+
+static std::mutex EventLock;
+static vector<TraceEvent> Events;
+static string TraceFileName;
+static std::chrono::steady_clock::time_point TraceStart;
+static std::atomic<int> ThreadCount{ 0 };
+
+static double Now()
+{
+	return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - TraceStart).count();
+}
+
+//Threads are numbered in the order they first record a zone, so they show up as tracks 1, 2, 3...
+static int GetThread()
+{
+	thread_local int Thread = ++ThreadCount;
+	return Thread;
+}
+
+void StartTracing(const string& FileName)
+{
+	std::lock_guard<std::mutex> Guard(EventLock);
+	TraceFileName = FileName;
+	TraceStart = std::chrono::steady_clock::now();
+	Events.clear();
+	TracingOn = true;
+}
+
+bool StartTracingFromEnvironment()
+{
+	const char* FileName = getenv("PATHFINDER_TRACE");
+	if (!FileName || !*FileName)
+		return false;
+
+	StartTracing(FileName);
+	return true;
+}
+
+bool StopTracing()
+{
+	if (!TracingOn)
+		return true;
+
+	std::lock_guard<std::mutex> Guard(EventLock);
+	TracingOn = false;
+
+	FILE* File = fopen(TraceFileName.c_str(), "w");
+	if (!File)
+		return false;
+
+	//Complete events ("X") with times in microseconds. Zone names are literals, so they need no escaping.
+	fprintf(File, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	for (size_t i = 0; i < Events.size(); ++i)
+	{
+		const TraceEvent& e = Events[i];
+		fprintf(File, "{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d}%s\n",
+			e.Name, e.Start, e.Duration, e.Thread, i + 1 < Events.size() ? "," : "");
+	}
+	fprintf(File, "]}\n");
+	Events = vector<TraceEvent>();
+	return fclose(File) == 0;
+}
+
+void TraceZone::Begin(const char* _Name)
+{
+	Name = _Name;
+	StartMicroseconds = Now();
+}
+
+void TraceZone::End()
+{
+	double EndMicroseconds = Now();
+	int Thread = GetThread();
+	std::lock_guard<std::mutex> Guard(EventLock);
+	if (TracingOn && Events.size() < MAX_EVENTS)
+		Events.push_back({ Name, StartMicroseconds, EndMicroseconds - StartMicroseconds, Thread });
+}
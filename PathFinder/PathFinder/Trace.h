@@ -0,0 +1,57 @@
+/**********************************************************
+* Description: Records how long parts of the program take, and
+* writes them out in the Chrome trace event format, which can
+* be opened in Perfetto (ui.perfetto.dev) or chrome://tracing.
+*
+* A TraceZone times the scope it lives in. Zones from every
+* thread are collected, each thread on its own track. Tracing
+* is off unless it is started, and then a zone costs one test
+* of a flag, without reading the clock.
+*
+* Setting the PATHFINDER_TRACE environment variable to a file
+* name turns tracing on for programs that call
+* StartTracingFromEnvironment, and the file is written when they
+* call StopTracing.
+**********************************************************/
+#pragma once
+#include <string>
+
+//Only read by zones. Set before any thread that records zones is started, and not changed while they run.
+extern bool TracingOn;
+
+//Start recording zones, to be written to FileName by StopTracing
+void StartTracing(const std::string& FileName);
+
+//Start recording zones if PATHFINDER_TRACE names a file. Returns true if it does.
+bool StartTracingFromEnvironment();
+
+//Stop recording and write every zone recorded so far. Returns false if the file can't be written.
+//Threads that record zones have to be stopped first.
+bool StopTracing();
+
+class TraceZone
+{
+public:
+	//Name has to outlive the trace, so it should be a string literal
+	TraceZone(const char* _Name)
+	{
+		if (TracingOn)
+			Begin(_Name);
+	}
+
+	~TraceZone()
+	{
+		if (Name)
+			End();
+	}
+
+	TraceZone(const TraceZone&) = delete;
+	TraceZone& operator=(const TraceZone&) = delete;
+
+private:
+	void Begin(const char* _Name);
+	void End();
+
+	const char* Name = nullptr; //Only set while tracing
+	double StartMicroseconds = 0;
+};
@@ -10,6 +10,29 @@
 * Left clicking on a tile will place an obstacle. 
 * Left clicking while holding CTRL on a tile will place the start tile. 
 * Right clicking while holding CTRL on a tile will place the end tile.
+* Pressing a number key will switch the algorithm used to find the path:
+*   1 - A* (runs on its own thread, so the path can show up a frame later)
+*   2 - A* with a bucket queue
+*   3 - Jump Point Search
+*   4 - JPS+
+*   5 - HPA* (hierarchical, close to but not always the shortest path)
+*   6 - D* Lite (repairs the last path while a streak is drawn)
+*   7 - Bitboard BFS (searches 64 tiles at a time)
+*   8 - A* spread over several frames (shows the search as it goes)
+*   9 - ARA* (improves its path for up to 1 ms, the title shows how close it is to the shortest)
+*   0 - Flow field (distances to the end tile, kept while only the start tile moves)
+* Pressing B switches to bidirectional A*, which searches from both ends at once on two threads.
+* Pressing L switches to A* guided by landmarks, which is much faster on mazes. The landmarks
+* are found again on their own thread after the map changes, and plain A* is used until then.
+* Pressing C switches to a Compressed Path Database, which knows the first step between every
+* pair of tiles. It is built again after the map changes, and the title shows its size and build time.
+* Pressing H hides or shows what the last search did and where the time of the frame went.
+* Only the tiles that change are drawn again, and the screen is only sent to the graphics card
+* on frames where something was drawn.
+* Pressing T switches to drawing the map with one texel per tile, which the graphics card
+* scales up to the screen, and back.
+* Setting the PATHFINDER_TRACE environment variable to a file name records how long each part
+* of every frame takes, and writes it to that file on exit for chrome://tracing or Perfetto.
 * 
 * Note: The code for this program commonly refers to something
 * that I dubbed a "streak". In this context, a streak is when
@@ -19,17 +42,16 @@
 #define OLC_PGE_APPLICATION
 #include <vector>
 #include <algorithm>
+#include <chrono>
 using std::vector;
+#include "Trace.h"
+#define OLC_TRACE_ZONE(name) TraceZone OlcZone(name)
 #include "olcPixelGameEngine.h"
-
-enum TileState
-{
-	EMPTY = 0, //Empty tile that can be used for pathing
-	START, //Start of the path
-	BLOCKED, //Obstacle that cannot be used for pathing
-	END, //End of the path
-	PATHED //Empty tile that has been used for pathing
-};
+#include "TileMap.h"
+#include "SearchContext.h"
+#include "PathSolver.h"
+#include "AStar.h"
+#include "AsyncSolver.h"
 
 enum StreakState
 {
@@ -38,27 +60,17 @@ enum StreakState
 	BLOCK //Current streak is placing blocking tiles
 };
 
-class Tile
-{
-public:
-	Tile(int _x, int _y, TileState s)
-	{
-		state = s;
-		x = _x;
-		y = _y;
-		g = 1;
-		h = 0;
-		f = INT_MAX;
-		parent = nullptr;
-	}
-	TileState state;
-	int x;
-	int y;
-	int g;
-	int h;
-	int f;
-	Tile* parent;
-};
+//Colour of each tile state, looked up by state. The sliced search colours the empty tiles it reached with the two after them.
+const olc::Pixel Palette[] = { olc::BLUE, olc::GREEN, olc::GREY, olc::RED, olc::YELLOW, olc::CYAN, olc::DARK_CYAN };
+const int OPENED_COLOUR = PATHED + 1;
+const int CLOSED_COLOUR = PATHED + 2;
+
+//Size of the box the stats are drawn in, in the top left corner of the screen
+const int STATS_WIDTH = 512;
+const int STATS_HEIGHT = 34;
+
+//The frame times in the stats are drawn again this often, so an idle screen still doesn't have to be sent every frame
+const float STATS_INTERVAL = 0.25f;
 
 class Finder : public olc::PixelGameEngine
 {
@@ -72,253 +84,484 @@ public:
 	int MapWidth = 64; //Map is 64 tiles wide
 	int MapHeight = 36; //Map is 36 tiles high
 	int TileSize = 16; //Each tile is 16 pixels
-	Tile* StartTile = nullptr;
-	Tile* EndTile = nullptr;
-	vector<Tile> Map;
-	StreakState StreakState = INACTIVE; //When a streak occurs, only allow changing one state to another
+	int StartTile = -1; //Index of the start tile in the map, or -1 if it hasn't been placed
+	int EndTile = -1; //Index of the end tile in the map, or -1 if it hasn't been placed
+	TileMap Map;
+	vector<int> PathedTiles; //Tiles that DrawPath set to PATHED, so they can be cleared without visiting the whole map
+	SearchContext Context; //Search planes and open lists, kept between searches to reuse their memory
+	PathSolver Paths{ Map }; //Every engine, kept up to date as tiles change
+	AsyncSolver Solver; //Runs A* on its own thread so a slow search doesn't hold up the frame
+	uint32_t GridVersion = 0; //Goes up every time a tile changes, so paths found for an older grid can be ignored
+	AStarSearch<IndexedHeap> SlicedSearch{ Map, Context, Context.OpenList };
+	vector<int> SlicedChanges; //Tiles the sliced search opened or closed since they were last marked dirty
+	int SliceExpansions = 40; //Most tiles the sliced search expands in one frame
+	double SliceMicroseconds = 2000; //Most time the sliced search spends in one frame
+	SearchEngine Engine = ASTAR; //The algorithm used to find the path. Chosen with the number keys.
+	StreakState Streak = INACTIVE; //When a streak occurs, only allow changing one state to another
+	SearchStats LastStats; //What the search that found the path on screen did
+	bool ShowStats = true; //Draw LastStats and the frame times over the map
+	double UpdateMicroseconds = 0; //Time the last OnUserUpdate took. The rest of the frame is the engine uploading and showing it.
+	vector<int> DirtyTiles; //Tiles that may look different than they did when they were last drawn
+	vector<uint8_t> TileDirty; //Whether each tile is in DirtyTiles already
+	vector<olc::Pixel> DrawnColours; //Colour each tile was last drawn with
+	bool ScreenChanged = true; //Something was drawn since the screen was last sent to the graphics card
+	float StatsAge = STATS_INTERVAL; //Seconds since the stats were last drawn
+	bool TexelMode = false; //Draw the map as one texel per tile and have the graphics card scale it up to the screen
+	olc::Renderable TileTexels; //One texel per tile, in the colour of the tile
+	olc::Renderable GridMask; //The size of the screen. Black over the gaps between tiles and clear everywhere else.
 
 	bool OnUserCreate() override
 	{
 		//Create the map consisting of empty tiles
-		for (int i = 0; i < MapWidth * MapHeight; ++i)
+		Map.Create(MapWidth, MapHeight);
+
+		//The screen is kept from frame to frame, so it is cleared once and every tile is drawn on the first frame.
+		//BLANK is never a tile colour, so no tile looks drawn yet.
+		Clear(olc::BLACK);
+		TileDirty.assign(Map.Size(), 0);
+		ForgetDrawnTiles();
+		SetLayerCustomRenderFunction(0, [this]() { ShowScreen(); });
+		SlicedSearch.RecordChanges(&SlicedChanges);
+
+		//The gaps between tiles never change, so their mask is made once
+		TileTexels.Create(MapWidth, MapHeight);
+		GridMask.Create(ScreenWidth(), ScreenHeight());
+		for (int y = 0; y < ScreenHeight(); ++y)
 		{
-			Map.push_back(Tile(i % MapWidth, i / MapWidth, EMPTY));
+			for (int x = 0; x < ScreenWidth(); ++x)
+			{
+				bool Gap = x % TileSize < 2 || x % TileSize >= TileSize - 2 || y % TileSize < 2 || y % TileSize >= TileSize - 2;
+				GridMask.Sprite()->SetPixel(x, y, Gap ? olc::BLACK : olc::BLANK);
+			}
 		}
+		GridMask.Decal()->Update();
+
+		Context.BeginSearch(Map.Size());
+		Paths.Prepare(Engine);
+		Solver.Start(MapWidth, MapHeight);
 		return true;
 	}
 
 	bool OnUserUpdate(float fElapsedTime) override
 	{
-		//Clear the screen to black
-		Clear(olc::BLACK);
+		auto UpdateStart = std::chrono::steady_clock::now();
+
+		//Show the path from the solver thread if it was found for the grid as it is now
+		AsyncSolver::Result Solved;
+		if (Solver.Poll(Solved) && Solved.Version == GridVersion && Engine == ASTAR)
+		{
+			ClearMap();
+			DrawPath(Solved.Path);
+			LastStats = Solved.Stats;
+		}
+
+		//Move the sliced search along by this frame's share
+		if (SlicedSearch.GetStatus() == SEARCHING)
+		{
+			TraceZone Zone("Sliced search step");
+			if (SlicedSearch.Step(SliceExpansions, SliceMicroseconds) == FOUND)
+				DrawPath(SlicedSearch.GetPath());
+			LastStats = Context.Stats;
+
+			//Only the tiles the step opened or closed change colour
+			for (int t : SlicedChanges)
+				MarkDirty(t);
+			SlicedChanges.clear();
+		}
+
+		//Pressing a number key switches to another algorithm and finds the path again with it
+		if (GetKey(olc::K1).bPressed) SetEngine(ASTAR);
+		if (GetKey(olc::K2).bPressed) SetEngine(ASTARBUCKETS);
+		if (GetKey(olc::K3).bPressed) SetEngine(JPS);
+		if (GetKey(olc::K4).bPressed) SetEngine(JPSPLUS);
+		if (GetKey(olc::K5).bPressed) SetEngine(HPA);
+		if (GetKey(olc::K6).bPressed) SetEngine(DSTARLITE);
+		if (GetKey(olc::K7).bPressed) SetEngine(BITBOARD);
+		if (GetKey(olc::K8).bPressed) SetEngine(ASTARSLICED);
+		if (GetKey(olc::K9).bPressed) SetEngine(ARASTAR);
+		if (GetKey(olc::K0).bPressed) SetEngine(FLOWFIELD);
+		if (GetKey(olc::B).bPressed) SetEngine(BIDIRECTIONAL);
+		if (GetKey(olc::L).bPressed) SetEngine(ASTARLANDMARKS);
+		if (GetKey(olc::C).bPressed) SetEngine(CPD);
+		if (GetKey(olc::H).bPressed) ToggleStats();
+		if (GetKey(olc::T).bPressed) ToggleTexelMode();
 
 		//Clicking when CTRL is held will place a start or end tile
 		if (GetKey(olc::CTRL).bHeld)
 		{
-			//Get the index into the Map vector by converting pixel space coordinates into tile space
+			//Get the index into the Map by converting pixel space coordinates into tile space
 			int index = (GetMouseY() / TileSize) * MapWidth + (GetMouseX() / TileSize);
 
-			if (GetMouse(0).bPressed && Map[index].state != START && Map[index].state != END)
+			if (GetMouse(0).bPressed && Map.State[index] != START && Map.State[index] != END)
 			{
 				//If the start tile has been placed somewhere else already, make sure to remove it first
-				if (StartTile != nullptr) StartTile->state = EMPTY;
+				if (StartTile != -1) SetTile(StartTile, EMPTY);
 
-				//Set the state of the new start tile and point the StartTile pointer to this tile
-				Map[index].state = START;
-				StartTile = &Map[index];
+				//Set the state of the new start tile and remember where it is
+				SetTile(index, START);
+				StartTile = index;
 
 				//If both the start and end tiles have been placed then do the algorithm
-				if (StartTile && EndTile)
-					DoAStar();
+				if (StartTile != -1 && EndTile != -1)
+					FindPath();
 			}
-			else if (GetMouse(1).bPressed && Map[index].state != END && Map[index].state != START)
+			else if (GetMouse(1).bPressed && Map.State[index] != END && Map.State[index] != START)
 			{
 				//If the end tile has been placed somewhere else already, make sure to remove it first
-				if (EndTile != nullptr) EndTile->state = EMPTY;
+				if (EndTile != -1) SetTile(EndTile, EMPTY);
 
-				//Set the state of the new end tile and point the EndTile pointer to this tile
-				Map[index].state = END;
-				EndTile = &Map[index];
+				//Set the state of the new end tile and remember where it is
+				SetTile(index, END);
+				EndTile = index;
 
 				//If both the start and end tiles have been placed then do the algorithm
-				if (StartTile && EndTile)
-					DoAStar();
+				if (StartTile != -1 && EndTile != -1)
+					FindPath();
 			}
 		}
 		else if (GetMouse(0).bHeld)
 		{
-			//Get the index into the Map vector by converting pixel space coordinates into tile space
+			//Get the index into the Map by converting pixel space coordinates into tile space
 			int index = (GetMouseY() / TileSize) * MapWidth + (GetMouseX() / TileSize);
 
 			//If this is the first frame that the left mouse button has been pressed then start a streak
 			if (GetMouse(0).bPressed)
 			{
-				if (Map[index].state == EMPTY || Map[index].state == PATHED)
-					StreakState = BLANK;
-				else if (Map[index].state == BLOCKED)
-					StreakState = BLOCK;
+				if (Map.State[index] == EMPTY || Map.State[index] == PATHED)
+					Streak = BLANK;
+				else if (Map.State[index] == BLOCKED)
+					Streak = BLOCK;
 			}
 
 			//Only change the current tile if it matches the current streak
-			if ((Map[index].state == EMPTY || Map[index].state == PATHED) && StreakState != BLOCK)
-				Map[index].state = BLOCKED;
-			else if (Map[index].state == BLOCKED && StreakState != BLANK)
-				Map[index].state = EMPTY;
+			bool Changed = false;
+			if ((Map.State[index] == EMPTY || Map.State[index] == PATHED) && Streak != BLOCK)
+			{
+				SetTile(index, BLOCKED);
+				Changed = true;
+			}
+			else if (Map.State[index] == BLOCKED && Streak != BLANK)
+			{
+				SetTile(index, EMPTY);
+				Changed = true;
+			}
 
-			//If both the start and end tiles have been placed then do the algorithm
-			if (StartTile && EndTile)
-				DoAStar();
+			//If both the start and end tiles have been placed then do the algorithm. While the mouse rests on a tile
+			//that was already changed there is nothing new to find, and searching again would restart a search still running.
+			if (Changed && StartTile != -1 && EndTile != -1)
+				FindPath();
 
 		}
 
 		//End the streak when the mouse is released
 		if (GetMouse(0).bReleased)
 		{
-			StreakState = INACTIVE;
+			Streak = INACTIVE;
 		}
 
-		//Drawing the map to the screen
-		for (int i = 0; i < MapWidth; ++i)
+		//Drawing the tiles that changed to the screen
+		auto DrawStart = std::chrono::steady_clock::now();
+		bool MapChanged = DrawMap();
+		double DrawMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - DrawStart).count();
+
+		//The graphics card scales the tile texels up to the screen, then the mask covers the gaps between the tiles
+		if (TexelMode)
 		{
-			for (int j = 0; j < MapHeight; ++j)
-			{
-				switch (Map[j * MapWidth + i].state)
-				{
-				case EMPTY:
-					FillRect(i * TileSize + 2, j * TileSize + 2, TileSize - 4, TileSize - 4, olc::BLUE);
-					break;
-				case BLOCKED:
-					FillRect(i * TileSize + 2, j * TileSize + 2, TileSize - 4, TileSize - 4, olc::GREY);
-					break;
-				case START:
-					FillRect(i * TileSize + 2, j * TileSize + 2, TileSize - 4, TileSize - 4, olc::GREEN);
-					break;
-				case END:
-					FillRect(i * TileSize + 2, j * TileSize + 2, TileSize - 4, TileSize - 4, olc::RED);
-					break;
-				case PATHED:
-					FillRect(i * TileSize + 2, j * TileSize + 2, TileSize - 4, TileSize - 4, olc::YELLOW);
-					break;
-				default:
-					FillRect(i * TileSize + 2, j * TileSize + 2, TileSize - 4, TileSize - 4, olc::DARK_MAGENTA);
-					break;
-				}
-			}
+			DrawDecal({ 0, 0 }, TileTexels.Decal(), { (float)TileSize, (float)TileSize });
+			DrawDecal({ 0, 0 }, GridMask.Decal());
+		}
+
+		//Tiles drawn under the stats cover them, so they are drawn again right away. Otherwise only a few times a second.
+		StatsAge += fElapsedTime;
+		if (ShowStats && (MapChanged || StatsAge >= STATS_INTERVAL))
+		{
+			DrawStats(fElapsedTime, DrawMicroseconds);
+			StatsAge = 0;
 		}
 
+		UpdateMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - UpdateStart).count();
 		return true;
 	}
 
-	void DrawPath(vector<Tile*> Path)
+	//Colour of a tile for its state
+	olc::Pixel GetTileColour(int Index)
 	{
-		//Set the state of each tile in the path that isn't the start or end state to PATHED
-		for (Tile* t : Path)
+		TileState State = Map.State[Index];
+
+		//The sliced search shows which tiles it has reached so far
+		if (State == EMPTY && Engine == ASTARSLICED)
 		{
-			if (t->state != START && t->state != END)
-				t->state = PATHED;
+			ListState List = Context.GetList(Index);
+			if (List == OPENED)
+				return Palette[OPENED_COLOUR];
+			if (List == CLOSED)
+				return Palette[CLOSED_COLOUR];
 		}
+		return Palette[State];
 	}
 
-	void ClearMap()
+	//Draw again the tiles whose colour changed since they were last drawn. In texel mode they are written to the
+	//tile texels, which are then sent to the graphics card. Returns true if any were drawn on the screen.
+	bool DrawMap()
 	{
-		for (int i = 0; i < MapWidth * MapHeight; ++i)
+		TraceZone Zone("Draw tiles");
+		olc::Pixel* Texels = TileTexels.Sprite()->GetData();
+		bool Drew = false;
+		for (int t : DirtyTiles)
+		{
+			TileDirty[t] = 0;
+			olc::Pixel Colour = GetTileColour(t);
+			if (Colour == DrawnColours[t])
+				continue;
+
+			if (TexelMode)
+				Texels[t] = Colour;
+			else
+				FillRect((t % MapWidth) * TileSize + 2, (t / MapWidth) * TileSize + 2, TileSize - 4, TileSize - 4, Colour);
+			DrawnColours[t] = Colour;
+			Drew = true;
+		}
+		DirtyTiles.clear();
+
+		if (Drew && TexelMode)
 		{
-			Map[i].g = 1;
-			Map[i].f = INT_MAX;
-			Map[i].h = 0;
-			Map[i].parent = nullptr;
-			if (Map[i].state == PATHED) Map[i].state = EMPTY;
+			TileTexels.Decal()->Update();
+			return false;
 		}
+
+		if (Drew)
+			ScreenChanged = true;
+		return Drew;
 	}
 
-	vector<Tile*> DoAStar()
+	//Have a tile checked the next time the map is drawn
+	void MarkDirty(int Index)
 	{
-		auto GetDistance = [](Tile* a, Tile* b)
+		if (!TileDirty[Index])
 		{
-			return abs(a->x - b->x) + abs(a->y - b->y);
-		};
+			TileDirty[Index] = 1;
+			DirtyTiles.push_back(Index);
+		}
+	}
 
-		ClearMap();
+	void MarkAllDirty()
+	{
+		for (int i = 0; i < Map.Size(); ++i)
+			MarkDirty(i);
+	}
 
-		Tile* Current = StartTile;
-		vector<Tile*> OpenList;
-		vector<Tile*> ClosedList;
+	//Layer 0 is drawn by this instead of by the engine, which would send the whole screen to the graphics card every frame.
+	//It is only sent when something was drawn on it.
+	void ShowScreen()
+	{
+		olc::LayerDesc& Layer = GetLayers()[0];
 
-		OpenList.push_back(StartTile);
+		//The only decals are the map in texel mode, so they go under the screen, which is clear but for the stats
+		for (auto& Decal : Layer.vecDecalInstance)
+			olc::renderer->DrawDecalQuad(Decal);
+		Layer.vecDecalInstance.clear();
 
-		while (OpenList.size() > 0)
+		olc::renderer->ApplyTexture(Layer.nResID);
+		if (ScreenChanged)
 		{
-			Tile* SmallestF = nullptr;
-			int SmallestFPos = 0;
+			TraceZone Zone("UpdateTexture");
+			olc::renderer->UpdateTexture(Layer.nResID, Layer.pDrawTarget);
+			ScreenChanged = false;
+		}
+		olc::renderer->DrawLayerQuad(Layer.vOffset, Layer.vScale, Layer.tint);
+	}
 
-			//Find the Tile in the open list with the smallest f value
-			for (int i = 0; i < OpenList.size(); ++i)
-			{
-				Tile* t = OpenList[i];
+	//Every tile is drawn again on the next frame, wherever the map is drawn now
+	void ForgetDrawnTiles()
+	{
+		DrawnColours.assign(Map.Size(), olc::BLANK);
+		MarkAllDirty();
+	}
 
-				if (!SmallestF || SmallestF->f > t->f)
-				{
-					SmallestF = t;
-					SmallestFPos = i;
-				}
+	//Switch between drawing each tile as a rectangle on the screen and as a texel the graphics card scales up
+	void ToggleTexelMode()
+	{
+		TexelMode = !TexelMode;
+		Clear(TexelMode ? olc::BLANK : olc::BLACK);
+		ScreenChanged = true;
+		StatsAge = STATS_INTERVAL;
+		ForgetDrawnTiles();
+	}
+
+	//Hiding the stats draws the tiles they covered again
+	void ToggleStats()
+	{
+		ShowStats = !ShowStats;
+		StatsAge = STATS_INTERVAL;
+		if (ShowStats)
+			return;
+
+		FillRect(0, 0, STATS_WIDTH, STATS_HEIGHT, TexelMode ? olc::BLANK : olc::BLACK);
+		ScreenChanged = true;
+		for (int j = 0; j * TileSize < STATS_HEIGHT && j < MapHeight; ++j)
+		{
+			for (int i = 0; i * TileSize < STATS_WIDTH && i < MapWidth; ++i)
+			{
+				DrawnColours[j * MapWidth + i] = olc::BLANK;
+				MarkDirty(j * MapWidth + i);
 			}
-			//Remove the Tile with the smallest f value from the open list
-			OpenList.erase(OpenList.begin() + SmallestFPos);
+		}
+	}
 
-			vector<Tile*> Neighbors;
-			Tile* Above = nullptr;
-			Tile* Below = nullptr;
-			Tile* Left = nullptr;
-			Tile* Right = nullptr;
+	//Show what the last search did, and split the frame into searching, drawing, and the engine's texture upload
+	void DrawStats(float ElapsedTime, double DrawMicroseconds)
+	{
+		//Of the time between the last two frames, what the last OnUserUpdate didn't use went to the engine
+		//uploading that frame's texture and showing it
+		double FrameMicroseconds = ElapsedTime * 1e6;
+		double EngineMicroseconds = std::max(0.0, FrameMicroseconds - UpdateMicroseconds);
+
+		char Lines[3][96];
+		snprintf(Lines[0], sizeof(Lines[0]), "Expanded %d  Pushes %d  Reopens %d  Peak open %d",
+			LastStats.Expanded, LastStats.Pushes, LastStats.Reopens, LastStats.PeakOpen);
+		snprintf(Lines[1], sizeof(Lines[1]), "Path %d tiles  Search %.3f ms", LastStats.PathLength, LastStats.Microseconds / 1000);
+		snprintf(Lines[2], sizeof(Lines[2]), "Frame %.2f ms  Update %.2f  Draw %.2f  Upload and show %.2f",
+			FrameMicroseconds / 1000, UpdateMicroseconds / 1000, DrawMicroseconds / 1000, EngineMicroseconds / 1000);
+
+		FillRect(0, 0, STATS_WIDTH, STATS_HEIGHT, olc::BLACK);
+		for (int i = 0; i < 3; ++i)
+			DrawString(4, 3 + i * 10, Lines[i], olc::WHITE);
+		ScreenChanged = true;
+	}
 
-			if (SmallestF->y > 0) 
-				Above = &Map[(SmallestF->y - 1) * MapWidth + (SmallestF->x)];
+	void SetTile(int Index, TileState NewState)
+	{
+		bool WasBlocked = Map.State[Index] == BLOCKED;
+		Map.State[Index] = NewState;
+		MarkDirty(Index);
+		++GridVersion;
 
-			if (SmallestF->y < MapHeight - 1) 
-				Below = &Map[(SmallestF->y + 1) * MapWidth + (SmallestF->x)];
+		//Anything precomputed from the map has to know when a tile stops or starts blocking paths
+		if (WasBlocked != (NewState == BLOCKED))
+		{
+			Paths.TileChanged(Index);
+			Solver.TileChanged(Index, NewState);
+		}
+	}
+
+	void SetEngine(SearchEngine NewEngine)
+	{
+		const char* Names[] = { "A*", "A* (bucket queue)", "Jump Point Search", "JPS+", "HPA*", "D* Lite", "Bitboard BFS", "A* (time sliced)", "ARA*", "Flow field", "Bidirectional A*", "A* (landmarks)", "Compressed Path Database" };
+		Engine = NewEngine;
+		Paths.Prepare(Engine);
+
+		//Only the sliced search colours the tiles it reached, so switching to or from it changes them
+		MarkAllDirty();
+		sAppName = std::string("Path Finder - ") + Names[Engine];
+
+		if (StartTile != -1 && EndTile != -1)
+			FindPath();
+	}
 
-			if (SmallestF->x > 0) 
-				Left = &Map[(SmallestF->y) * MapWidth + (SmallestF->x - 1)];
+	//Find the path with the chosen algorithm and show it. A* only starts the search, and returns an empty path.
+	vector<int> FindPath()
+	{
+		//When the start and end tiles are walled off from each other there is nothing to search for
+		if (!Paths.Connected(StartTile, EndTile))
+		{
+			ClearMap();
+			LastStats = SearchStats();
+			return vector<int>();
+		}
+
+		switch (Engine)
+		{
+		case ASTAR:
+			PostAStar();
+			return vector<int>();
+		case ASTARSLICED:
+			StartSlicedSearch();
+			return vector<int>();
+		default:
+			break;
+		}
 
-			if (SmallestF->x < MapWidth - 1) 
-				Right = &Map[(SmallestF->y) * MapWidth + (SmallestF->x + 1)];
+		ClearMap();
+		double Bound;
+		vector<int> Path = Paths.FindPath(Context, Engine, StartTile, EndTile, &Bound);
+		DrawPath(Path);
+		LastStats = Context.Stats;
 
+		//Show how far from the shortest path the anytime search's path can be
+		if (Engine == ARASTAR)
+		{
+			char Title[64];
+			snprintf(Title, sizeof(Title), "Path Finder - ARA* (at most %.1fx the shortest)", Bound);
+			sAppName = Title;
+		}
 
-			if (Above && Above->state != BLOCKED && Above->y < SmallestF->y) 
-				Neighbors.push_back(Above);
-			if (Below && Below->state != BLOCKED && Below->y > SmallestF->y) 
-				Neighbors.push_back(Below);
-			if (Left && Left->state != BLOCKED && Left->x < SmallestF->x) 
-				Neighbors.push_back(Left);
-			if (Right && Right->state != BLOCKED && Right->x > SmallestF->x) 
-				Neighbors.push_back(Right);
+		//Show what the path database costs, since it may have just been built again
+		if (Engine == CPD)
+		{
+			char Title[96];
+			snprintf(Title, sizeof(Title), "Path Finder - Compressed Path Database (%.1f KB, built in %.1f ms)",
+				Paths.Database.GetSizeBytes() / 1024.0, Paths.Database.GetBuildMilliseconds());
+			sAppName = Title;
+		}
+		return Path;
+	}
 
-			for (Tile* t : Neighbors)
+	void DrawPath(const vector<int>& Path)
+	{
+		//Set the state of each tile in the path that isn't the start or end state to PATHED
+		for (int t : Path)
+		{
+			if (Map.State[t] != START && Map.State[t] != END)
 			{
-				//If neighbor is the goal
-				if (t->x == EndTile->x && t->y == EndTile->y)
-				{
-					t->parent = SmallestF;
-					vector<Tile*> Path;
-					Tile* itr = EndTile;
-
-					while (itr != nullptr)
-					{
-						Path.push_back(itr);
-						itr = itr->parent;
-					}
-					std::reverse(Path.begin(), Path.end());
-					DrawPath(Path);
-					return Path;
-				}
-				//Else if the neighbor is not in the closed list
-				else if (std::find(ClosedList.begin(), ClosedList.end(), t) == ClosedList.end())
-				{
-					t->g = SmallestF->g + 1;
-					t->h = GetDistance(EndTile, t);
-					int NewF = t->g + t->h;
-
-
-					if (t->f > NewF)
-					{
-						OpenList.push_back(t);
-						t->f = NewF;
-						t->parent = SmallestF;
-					}
-				}
+				Map.State[t] = PATHED;
+				PathedTiles.push_back(t);
+				MarkDirty(t);
 			}
+		}
+	}
 
-			ClosedList.push_back(SmallestF);
+	void ClearMap()
+	{
+		//Only the tiles of the last path need to be changed back to empty
+		for (int t : PathedTiles)
+		{
+			if (Map.State[t] == PATHED) Map.State[t] = EMPTY;
+			MarkDirty(t);
 		}
-		return vector<Tile*>(); //Return empty path if it cannot be found
+		PathedTiles.clear();
+
+		//The next search starts over in the context, so a sliced search that is still going can't carry on
+		SlicedSearch.Stop();
+	}
+
+	//A* runs on the solver's thread. The path is drawn by OnUserUpdate once it is ready.
+	void PostAStar()
+	{
+		Solver.Post(StartTile, EndTile, GridVersion);
+	}
+
+	//The sliced search is moved along a little every frame by OnUserUpdate
+	void StartSlicedSearch()
+	{
+		ClearMap();
+		SlicedSearch.Begin(StartTile, EndTile);
+
+		//Tiles the last sliced search reached go back to empty
+		MarkAllDirty();
+		SlicedChanges.clear();
 	}
 };
 
 int main()
 {
-	Finder finder;
-	if (finder.Construct(1024, 576, 1, 1))
-		finder.Start();
+	//Set PATHFINDER_TRACE to a file name to record a trace of every frame
+	StartTracingFromEnvironment();
+	{
+		Finder finder;
+		if (finder.Construct(1024, 576, 1, 1))
+			finder.Start();
+	}
+	StopTracing();
 
 	return 0;
 }
\ No newline at end of file
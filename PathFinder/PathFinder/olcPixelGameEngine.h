@@ -256,6 +256,11 @@ int main()
 
 #define UNUSED(x) (void)(x)
 
+// Times the scope it is in. Define it before including this file to trace the phases of a frame.
+#ifndef OLC_TRACE_ZONE
+	#define OLC_TRACE_ZONE(name)
+#endif
+
 
 #if !defined(OLC_GFX_OPENGL33) && !defined(OLC_GFX_DIRECTX10)
 	#define OLC_GFX_OPENGL10
@@ -2372,46 +2377,53 @@ namespace olc
 		float fElapsedTime = elapsedTime.count();
 		fLastElapsed = fElapsedTime;		
 
-		// Some platforms will need to check for events
-		platform->HandleSystemEvent();
-
-		// Compare hardware input states from previous frame
-		auto ScanHardware = [&](HWButton* pKeys, bool* pStateOld, bool* pStateNew, uint32_t nKeyCount)
 		{
-			for (uint32_t i = 0; i < nKeyCount; i++)
+			OLC_TRACE_ZONE("Input scan");
+
+			// Some platforms will need to check for events
+			platform->HandleSystemEvent();
+
+			// Compare hardware input states from previous frame
+			auto ScanHardware = [&](HWButton* pKeys, bool* pStateOld, bool* pStateNew, uint32_t nKeyCount)
 			{
-				pKeys[i].bPressed = false;
-				pKeys[i].bReleased = false;
-				if (pStateNew[i] != pStateOld[i])
+				for (uint32_t i = 0; i < nKeyCount; i++)
 				{
-					if (pStateNew[i])
-					{
-						pKeys[i].bPressed = !pKeys[i].bHeld;
-						pKeys[i].bHeld = true;
-					}
-					else
+					pKeys[i].bPressed = false;
+					pKeys[i].bReleased = false;
+					if (pStateNew[i] != pStateOld[i])
 					{
-						pKeys[i].bReleased = true;
-						pKeys[i].bHeld = false;
+						if (pStateNew[i])
+						{
+							pKeys[i].bPressed = !pKeys[i].bHeld;
+							pKeys[i].bHeld = true;
+						}
+						else
+						{
+							pKeys[i].bReleased = true;
+							pKeys[i].bHeld = false;
+						}
 					}
+					pStateOld[i] = pStateNew[i];
 				}
-				pStateOld[i] = pStateNew[i];
-			}
-		};
+			};
 
-		ScanHardware(pKeyboardState, pKeyOldState, pKeyNewState, 256);
-		ScanHardware(pMouseState, pMouseOldState, pMouseNewState, nMouseButtons);
+			ScanHardware(pKeyboardState, pKeyOldState, pKeyNewState, 256);
+			ScanHardware(pMouseState, pMouseOldState, pMouseNewState, nMouseButtons);
 
-		// Cache mouse coordinates so they remain consistent during frame
-		vMousePos = vMousePosCache;
-		nMouseWheelDelta = nMouseWheelDeltaCache;
-		nMouseWheelDeltaCache = 0;
+			// Cache mouse coordinates so they remain consistent during frame
+			vMousePos = vMousePosCache;
+			nMouseWheelDelta = nMouseWheelDeltaCache;
+			nMouseWheelDeltaCache = 0;
+		}
 
 		renderer->ClearBuffer(olc::BLACK, true);
 
 		// Handle Frame Update
-		if (!OnUserUpdate(fElapsedTime))
-			bAtomActive = false;
+		{
+			OLC_TRACE_ZONE("OnUserUpdate");
+			if (!OnUserUpdate(fElapsedTime))
+				bAtomActive = false;
+		}
 
 		// Display Frame
 		renderer->UpdateViewport(vViewPos, vViewSize);
@@ -2431,6 +2443,7 @@ namespace olc
 					renderer->ApplyTexture(layer->nResID);
 					if (layer->bUpdate)
 					{
+						OLC_TRACE_ZONE("UpdateTexture");
 						renderer->UpdateTexture(layer->nResID, layer->pDrawTarget);
 						layer->bUpdate = false;
 					}
@@ -2451,7 +2464,10 @@ namespace olc
 		}
 
 		// Present Graphics to screen
-		renderer->DisplayFrame();
+		{
+			OLC_TRACE_ZONE("DisplayFrame");
+			renderer->DisplayFrame();
+		}
 
 		// Update Title Bar
 		fFrameTimer += fElapsedTime;
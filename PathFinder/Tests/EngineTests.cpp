@@ -0,0 +1,217 @@
+/**********************************************************
+* Description: Checks every engine against a breadth first
+* search on random maps.
+*
+* Each map gets a few rounds of random tile edits, made through
+* PathSolver::TileChanged the way the app makes them. After
+* each round, every engine is asked for the same queries in a
+* shuffled order, all of them sharing one SearchContext, and a
+* few queries have the same start and end tile. A path has to
+* go from the start tile to the end tile one step at a time
+* through tiles that aren't blocked, and has to be as short as
+* the breadth first search's, except for HPA* and ARA*, which
+* can only be as short or longer (ARA* by at most its bound).
+* The landmark queries wait for the landmarks of the edited grid,
+* so they are guided by them and not by Manhattan distance.
+*
+* The same queries are then run through a BatchSolver with every
+* engine, once as they are and once all sharing one end tile.
+* The engines a batch can't run side by side are swapped for
+* plain A*, so every batch path but HPA*'s has to be the
+* shortest.
+*
+* Prints every failure and returns 1 if there were any.
+**********************************************************/
+#include <cstdio>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <random>
+#include <chrono>
+#include <thread>
+#include "PathSolver.h"
+#include "BatchSolver.h"
+#include "PathCheck.h"
+using std::vector;
+using std::pair;
+
+const SearchEngine AllEngines[] = { ASTAR, ASTARBUCKETS, JPS, JPSPLUS, HPA, DSTARLITE, BITBOARD, ASTARSLICED, ARASTAR, FLOWFIELD, BIDIRECTIONAL, ASTARLANDMARKS, CPD };
+const char* EngineNames[] = { "A*", "A* buckets", "JPS", "JPS+", "HPA*", "D* Lite", "Bitboard", "Sliced A*", "ARA*", "Flow field", "Bidirectional", "Landmarks", "CPD" };
+
+const int ROUNDS = 6; //Rounds of edits on each map
+const int EDITS_PER_ROUND = 25;
+const int QUERIES_PER_ROUND = 24;
+const int SAME_TILE_QUERIES = 3; //Queries in each round whose start and end tiles are the same
+const double LANDMARK_TIMEOUT_SECONDS = 30; //Longest to wait for the landmarks of an edited grid
+
+static int Failures = 0;
+
+static void Fail(const char* Engine, int Width, int Height, int Start, int End, const char* What)
+{
+	printf("FAILED %s on %dx%d from %d to %d: %s\n", Engine, Width, Height, Start, End, What);
+	++Failures;
+}
+
+//Check one path against the shortest length. MaxRatio is how many times longer than the shortest it may be.
+static void CheckPath(const TileMap& Map, const char* Engine, const vector<int>& Path, int Start, int End, int Shortest, double MaxRatio)
+{
+	if (Shortest == -1)
+	{
+		if (!Path.empty())
+			Fail(Engine, Map.Width, Map.Height, Start, End, "found a path where there is none");
+		return;
+	}
+
+	if (Path.empty())
+	{
+		Fail(Engine, Map.Width, Map.Height, Start, End, "found no path");
+		return;
+	}
+
+	if (!IsValidPath(Map, Path, Start, End))
+	{
+		Fail(Engine, Map.Width, Map.Height, Start, End, "path doesn't go from the start tile to the end tile one step at a time around walls");
+		return;
+	}
+
+	int Length = (int)Path.size() - 1;
+	if (Length < Shortest)
+		Fail(Engine, Map.Width, Map.Height, Start, End, "path is shorter than the shortest");
+	else if (Length > Shortest * MaxRatio + 1e-9)
+		Fail(Engine, Map.Width, Map.Height, Start, End, "path is longer than it may be");
+}
+
+//Wait for the landmark builder to catch up with the edits. Returns false if it takes too long.
+static bool WaitForLandmarks(PathSolver& Paths)
+{
+	auto WaitStart = std::chrono::steady_clock::now();
+	while (!Paths.Landmarks.GetTable())
+	{
+		if (std::chrono::duration<double>(std::chrono::steady_clock::now() - WaitStart).count() > LANDMARK_TIMEOUT_SECONDS)
+			return false;
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	return true;
+}
+
+//Run Queries through the batch with every engine. Only HPA* may find longer paths.
+static void CheckBatches(const TileMap& Map, BatchSolver& Batch, const vector<pair<int, int>>& Queries, const vector<int>& Shortest)
+{
+	for (SearchEngine Engine : AllEngines)
+	{
+		vector<CompactPath> Found = Batch.FindPaths(Queries, Engine);
+		char Name[32];
+		snprintf(Name, sizeof(Name), "Batch %s", EngineNames[Engine]);
+		for (size_t q = 0; q < Queries.size(); ++q)
+			CheckPath(Map, Name, Found[q].Unpack(Map), Queries[q].first, Queries[q].second, Shortest[q], Engine == HPA ? 1e9 : 1);
+	}
+}
+
+static int RandomFreeTile(const TileMap& Map, std::mt19937& Random)
+{
+	std::uniform_int_distribution<int> Pick(0, Map.Size() - 1);
+	while (true)
+	{
+		int t = Pick(Random);
+		if (Map.State[t] != BLOCKED)
+			return t;
+	}
+}
+
+static void TestMap(int Width, int Height, unsigned Seed)
+{
+	std::mt19937 Random(Seed);
+	std::uniform_int_distribution<int> Percent(0, 99);
+
+	TileMap Map;
+	Map.Create(Width, Height);
+	for (TileState& s : Map.State)
+		s = Percent(Random) < 25 ? BLOCKED : EMPTY;
+
+	PathSolver Paths(Map);
+	SearchContext Context;
+	BatchSolver Batch(Paths, 2);
+	vector<int> Distances;
+	vector<int> Queue;
+	vector<SearchEngine> Order(std::begin(AllEngines), std::end(AllEngines));
+	for (SearchEngine Engine : Order)
+		Paths.Prepare(Engine);
+
+	for (int Round = 0; Round < ROUNDS; ++Round)
+	{
+		//Every round but the first starts with edits, like a streak in the app
+		if (Round > 0)
+		{
+			std::uniform_int_distribution<int> Pick(0, Map.Size() - 1);
+			for (int e = 0; e < EDITS_PER_ROUND; ++e)
+			{
+				int t = Pick(Random);
+				Map.State[t] = Map.State[t] == BLOCKED ? EMPTY : BLOCKED;
+				Paths.TileChanged(t);
+			}
+		}
+
+		vector<pair<int, int>> Queries;
+		for (int q = 0; q < QUERIES_PER_ROUND; ++q)
+		{
+			int Start = RandomFreeTile(Map, Random);
+			Queries.emplace_back(Start, q < SAME_TILE_QUERIES ? Start : RandomFreeTile(Map, Random));
+		}
+
+		vector<int> Shortest;
+		for (const pair<int, int>& Query : Queries)
+			Shortest.push_back(FindShortestLength(Map, Query.first, Query.second, Distances, Queue));
+
+		//The engines take turns in a different order every round, so each one searches after the others in the same context
+		std::shuffle(Order.begin(), Order.end(), Random);
+		for (SearchEngine Engine : Order)
+		{
+			if (Engine == ASTARLANDMARKS && !WaitForLandmarks(Paths))
+			{
+				Fail("Landmarks", Width, Height, -1, -1, "the landmarks were never built for the edited grid");
+				continue;
+			}
+
+			for (size_t q = 0; q < Queries.size(); ++q)
+			{
+				double Bound = 1;
+				vector<int> Path = Paths.FindPath(Context, Engine, Queries[q].first, Queries[q].second, &Bound);
+				double MaxRatio = Engine == HPA ? 1e9 : Engine == ARASTAR ? Bound : 1;
+				CheckPath(Map, EngineNames[Engine], Path, Queries[q].first, Queries[q].second, Shortest[q], MaxRatio);
+			}
+		}
+
+		//A batch spreads the same queries over several contexts at once. With one end tile for all of them,
+		//the flow field is used instead of being swapped for A*.
+		CheckBatches(Map, Batch, Queries, Shortest);
+		int SharedEnd = Queries.back().second;
+		vector<pair<int, int>> SharedEndQueries;
+		vector<int> SharedEndShortest;
+		for (const pair<int, int>& Query : Queries)
+		{
+			SharedEndQueries.emplace_back(Query.first, SharedEnd);
+			SharedEndShortest.push_back(FindShortestLength(Map, Query.first, SharedEnd, Distances, Queue));
+		}
+		CheckBatches(Map, Batch, SharedEndQueries, SharedEndShortest);
+	}
+}
+
+int main()
+{
+	//Rows of under one word, a few words, and enough words for the four at a time bitboard search
+	const int Sizes[][2] = { { 7, 7 }, { 24, 17 }, { 64, 36 }, { 70, 45 }, { 300, 12 } };
+	unsigned Seed = 1;
+	for (const auto& Size : Sizes)
+	{
+		for (int Repeat = 0; Repeat < 2; ++Repeat)
+			TestMap(Size[0], Size[1], Seed++);
+	}
+
+	if (Failures)
+	{
+		printf("%d failures\n", Failures);
+		return 1;
+	}
+	printf("Every engine matched the breadth first search\n");
+	return 0;
+}